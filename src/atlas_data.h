@@ -0,0 +1,24 @@
+// Generated by atlas_packer, do not edit (regenerate with the bake_atlas target)
+#ifndef ATLAS_DATA_H
+#define ATLAS_DATA_H
+
+#define ATLAS_WIDTH 256
+#define ATLAS_HEIGHT 64
+#define ATLAS_SPRITE_COUNT 5
+
+#define ATLAS_SPRITE_SMALL_A 0
+#define ATLAS_SPRITE_MED_B 1
+#define ATLAS_SPRITE_BIG_A 2
+#define ATLAS_SPRITE_PLAYER 3
+#define ATLAS_SPRITE_WHITE 4
+
+// Source rectangles into the atlas texture, indexed by ATLAS_SPRITE_*
+static const Rectangle atlasRects[ATLAS_SPRITE_COUNT] = {
+    { 2, 2, 48, 48 },
+    { 52, 2, 48, 48 },
+    { 102, 2, 48, 48 },
+    { 152, 2, 48, 48 },
+    { 202, 2, 4, 4 },
+};
+
+#endif // ATLAS_DATA_H
@@ -0,0 +1,40 @@
+/*******************************************************************************************
+*
+*   embedded - Resources compiled into the executable
+*
+********************************************************************************************/
+
+#include "embedded.h"
+
+#include <stddef.h>                         // Required for: NULL
+#include <string.h>                         // Required for: strcmp()
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+#if defined(SUPPORT_EMBEDDED_RESOURCES)
+extern const EmbeddedFile embeddedFiles[];  // Defined in generated embedded_resources.c
+extern const int embeddedFileCount;
+#else
+static const EmbeddedFile *embeddedFiles = NULL;
+static const int embeddedFileCount = 0;
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+const unsigned char *GetEmbeddedData(const char *name, int *size)
+{
+    for (int i = 0; i < embeddedFileCount; i++)
+    {
+        if (strcmp(embeddedFiles[i].name, name) == 0)
+        {
+            if (size != NULL) *size = embeddedFiles[i].size;
+            return embeddedFiles[i].data;
+        }
+    }
+
+    if (size != NULL) *size = 0;
+
+    return NULL;
+}
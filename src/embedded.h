@@ -0,0 +1,51 @@
+/*******************************************************************************************
+*
+*   embedded - Resources compiled into the executable
+*
+*   With SUPPORT_EMBEDDED_RESOURCES the build generates a C file with the contents of the
+*   runtime assets as byte arrays (see tools/embed_resources.cmake), so they are available
+*   without any file access, the same way entries of the packed archive are (see pak.h).
+*
+*   CONFIGURATION:
+*       #define SUPPORT_EMBEDDED_RESOURCES
+*           Resolve assets from the generated arrays first, files not embedded are still
+*           loaded from disk. Without it GetEmbeddedData() always returns NULL
+*
+********************************************************************************************/
+
+#ifndef EMBEDDED_H
+#define EMBEDDED_H
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+// Embedded data alignment, pre-decoded sounds are used in place as float samples
+#if defined(_MSC_VER)
+    #define EMBEDDED_ALIGN __declspec(align(16))
+#else
+    #define EMBEDDED_ALIGN __attribute__((aligned(16)))
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    const char *name;                       // File name, i.e. "atlas.png"
+    const unsigned char *data;
+    int size;
+} EmbeddedFile;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+const unsigned char *GetEmbeddedData(const char *name, int *size);     // Get embedded file data by name, NULL if not embedded
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // EMBEDDED_H
@@ -0,0 +1,90 @@
+/*******************************************************************************************
+*
+*   fixed - 16.16 fixed point math and the simulation number type
+*
+*   Gameplay simulation (movement, wrapping, collisions, timers) uses SimValue/SimVector2
+*   and the SIM_* macros below. By default they map to float and libm, with
+*   SUPPORT_FIXED_POINT they map to 16.16 fixed point integers and table driven trig, so
+*   every target (x86, ARM, wasm) computes bit identical results: no libm differences,
+*   no FMA contraction, no extended precision. Required for lockstep and cross target replays.
+*
+*   Rendering converts to float with SIM_TO_FLOAT()/SIM_TO_VECTOR2(), those results are
+*   never fed back into the simulation.
+*
+*   NOTE: 16.16 holds values in [-32768, 32768), world coordinates and angles must stay
+*   in range, angles are wrapped to [0, 360) by gameplay code
+*
+*   CONFIGURATION:
+*       #define SUPPORT_FIXED_POINT
+*           Deterministic simulation, 16.16 fixed point values and a fixed tick time
+*           (GAME_TICK_RATE) instead of the measured frame time
+*
+********************************************************************************************/
+
+#ifndef FIXED_H
+#define FIXED_H
+
+#include "raylib.h"                         // Required for: Vector2, DEG2RAD
+
+#include <math.h>                           // Required for: sinf(), cosf(), fabsf()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define FIXED_SHIFT                 16
+#define FIXED_ONE                   (1 << FIXED_SHIFT)
+#define FIXED_SIN_TABLE_SIZE        1024    // Quarter wave table steps, 90/1024 degrees resolution
+
+// Constant to fixed point, only for compile time constants, conversion happens in the compiler
+#define FIXED(value)                ((int)((value)*65536.0))
+
+#if defined(SUPPORT_FIXED_POINT)
+    typedef int SimValue;
+    #define SIM(value)              FIXED(value)
+    #define SIM_FROM_INT(value)     ((value)*FIXED_ONE)
+    #define SIM_TO_INT(value)       ((value)/FIXED_ONE)
+    #define SIM_TO_FLOAT(value)     ((float)(value)/FIXED_ONE)
+    #define SIM_FROM_FLOAT(value)   ((int)((value)*FIXED_ONE))     // Presentation only, never on simulation paths
+    #define SIM_MUL(a, b)           FixedMul(a, b)
+    #define SIM_ABS(value)          (((value) < 0)? -(value) : (value))
+    #define SIM_SIN_DEG(degrees)    FixedSinDeg(degrees)
+    #define SIM_COS_DEG(degrees)    FixedCosDeg(degrees)
+#else
+    typedef float SimValue;
+    #define SIM(value)              ((float)(value))
+    #define SIM_FROM_INT(value)     ((float)(value))
+    #define SIM_TO_INT(value)       ((int)(value))
+    #define SIM_TO_FLOAT(value)     (value)
+    #define SIM_FROM_FLOAT(value)   (value)
+    #define SIM_MUL(a, b)           ((a)*(b))
+    #define SIM_ABS(value)          fabsf(value)
+    #define SIM_SIN_DEG(degrees)    sinf((degrees)*DEG2RAD)
+    #define SIM_COS_DEG(degrees)    cosf((degrees)*DEG2RAD)
+#endif
+
+#define SIM_TO_VECTOR2(vector)      ((Vector2){ SIM_TO_FLOAT((vector).x), SIM_TO_FLOAT((vector).y) })
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    SimValue x;
+    SimValue y;
+} SimVector2;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+int FixedMul(int a, int b);                 // Multiply 16.16 values, result rounded toward negative infinity
+int FixedSinDeg(int degrees);               // Sine of a 16.16 angle in degrees, any range
+int FixedCosDeg(int degrees);               // Cosine of a 16.16 angle in degrees, any range
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // FIXED_H
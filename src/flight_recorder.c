@@ -0,0 +1,222 @@
+/*******************************************************************************************
+*
+*   flight_recorder - Last seconds of game input and state, dumped to a file on crash
+*
+*   NOTE: Crash handler only touches static buffers and calls async-signal-safe functions,
+*   the dump file name is copied at init so no formatting happens in the handler
+*
+*   NOTE: On POSIX the handler runs on its own stack, stack overflows can still be dumped
+*
+********************************************************************************************/
+
+#include "flight_recorder.h"
+
+#if !defined(PLATFORM_WEB)
+    #define FLIGHT_RECORDER_SIGNALS
+#endif
+
+#if defined(FLIGHT_RECORDER_SIGNALS)
+
+#include "snapshot.h"                       // Required for: SnapshotSave(), SNAPSHOT_MAX_SIZE
+
+#include <string.h>                         // Required for: strlen(), memcpy()
+#include <signal.h>                         // Required for: signal(), raise(), sigaction()
+#include <fcntl.h>                          // Required for: open() flags
+
+#if defined(_WIN32)
+    #include <io.h>                         // Required for: _open(), _write(), _close()
+    #include <sys/stat.h>                   // Required for: _S_IREAD, _S_IWRITE
+    #define OpenDumpFile(fileName) _open(fileName, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE)
+    #define WriteDumpFile(file, data, size) _write(file, data, (unsigned int)(size))
+    #define CloseDumpFile(file) _close(file)
+#else
+    #include <unistd.h>                     // Required for: write(), close()
+    #define OpenDumpFile(fileName) open(fileName, O_WRONLY | O_CREAT | O_TRUNC, 0644)
+    #define WriteDumpFile(file, data, size) write(file, data, (size_t)(size))
+    #define CloseDumpFile(file) close(file)
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define FLIGHT_RECORDER_MAX_PATH    512
+#define FLIGHT_RECORDER_STACK_SIZE  65536   // Crash handler stack (POSIX)
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static const int crashSignals[] = {
+    SIGSEGV, SIGABRT, SIGFPE, SIGILL,
+#if defined(SIGBUS)
+    SIGBUS,
+#endif
+};
+
+static char dumpFileName[FLIGHT_RECORDER_MAX_PATH] = { 0 };
+static volatile sig_atomic_t installed = 0;
+static volatile sig_atomic_t dumping = 0;
+
+static FlightTick ticks[FLIGHT_RECORDER_TICKS] = { 0 };
+static unsigned int tickCount = 0;          // Ticks recorded since init, next record goes to tickCount%FLIGHT_RECORDER_TICKS
+
+static unsigned char snapshots[FLIGHT_RECORDER_SNAPSHOTS][SNAPSHOT_MAX_SIZE] = { 0 };
+static volatile int snapshotSizes[FLIGHT_RECORDER_SNAPSHOTS] = { 0 };    // 0 while the slot is empty or being written
+static int nextSnapshot = 0;
+
+#if !defined(_WIN32)
+static unsigned char handlerStack[FLIGHT_RECORDER_STACK_SIZE] = { 0 };
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void CrashHandler(int signalNumber);
+static void WriteDump(int signalNumber);
+static bool WriteAll(int file, const void *data, int size);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+bool FlightRecorderInit(const char *fileName)
+{
+    FlightRecorderShutdown();
+
+    if (strlen(fileName) >= FLIGHT_RECORDER_MAX_PATH) return false;
+    memcpy(dumpFileName, fileName, strlen(fileName) + 1);
+
+#if defined(_WIN32)
+    // NOTE: Handlers installed with signal() are reset to default before being called
+    for (int i = 0; i < (int)(sizeof(crashSignals)/sizeof(crashSignals[0])); i++) signal(crashSignals[i], CrashHandler);
+#else
+    stack_t stack = { 0 };
+    stack.ss_sp = handlerStack;
+    stack.ss_size = sizeof(handlerStack);
+    sigaltstack(&stack, NULL);
+
+    struct sigaction action = { 0 };
+    action.sa_handler = CrashHandler;
+    action.sa_flags = SA_ONSTACK | SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+
+    for (int i = 0; i < (int)(sizeof(crashSignals)/sizeof(crashSignals[0])); i++) sigaction(crashSignals[i], &action, NULL);
+#endif
+
+    installed = 1;
+
+    return true;
+}
+
+void FlightRecorderShutdown(void)
+{
+    if (!installed) return;
+
+    for (int i = 0; i < (int)(sizeof(crashSignals)/sizeof(crashSignals[0])); i++) signal(crashSignals[i], SIG_DFL);
+
+    installed = 0;
+}
+
+void FlightRecorderTick(const GameState *game, unsigned int input, float frameTime)
+{
+    ticks[tickCount%FLIGHT_RECORDER_TICKS] = (FlightTick){
+        game->simTick, input, frameTime,
+        game->currentAsteroids, game->liveAsteroids, game->lives, game->asteroidScore, SIM_TO_FLOAT(game->beamCharge), game->stateHash
+    };
+    tickCount++;
+
+    // Snapshots go by recorded ticks, simulation tick stops while the game is over
+    if ((tickCount%FLIGHT_RECORDER_SNAPSHOT_INTERVAL) == 0)
+    {
+        snapshotSizes[nextSnapshot] = 0;
+        snapshotSizes[nextSnapshot] = SnapshotSave(game, snapshots[nextSnapshot], SNAPSHOT_MAX_SIZE);
+        nextSnapshot = (nextSnapshot + 1)%FLIGHT_RECORDER_SNAPSHOTS;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+static void CrashHandler(int signalNumber)
+{
+    if (!dumping)
+    {
+        dumping = 1;
+        WriteDump(signalNumber);
+    }
+
+    // Default action for the same signal: terminate, core dump
+    signal(signalNumber, SIG_DFL);
+    raise(signalNumber);
+}
+
+// Write rings to the dump file, oldest entries first
+// NOTE: Called from the crash handler, async-signal-safe calls only
+static void WriteDump(int signalNumber)
+{
+    int file = OpenDumpFile(dumpFileName);
+    if (file < 0) return;
+
+    unsigned int count = (tickCount < FLIGHT_RECORDER_TICKS)? tickCount : FLIGHT_RECORDER_TICKS;
+    unsigned int first = (tickCount - count)%FLIGHT_RECORDER_TICKS;
+
+    FlightDumpHeader header = { { 0 }, FLIGHT_RECORDER_VERSION, signalNumber, count, 0 };
+    memcpy(header.magic, FLIGHT_RECORDER_MAGIC, 4);
+    for (int i = 0; i < FLIGHT_RECORDER_SNAPSHOTS; i++) if (snapshotSizes[i] > 0) header.snapshotCount++;
+
+    bool written = WriteAll(file, &header, sizeof(header));
+
+    // Ring wraps at most once: first..end, then start..first
+    unsigned int firstPart = ((first + count) > FLIGHT_RECORDER_TICKS)? (FLIGHT_RECORDER_TICKS - first) : count;
+    written = written && WriteAll(file, &ticks[first], (int)(firstPart*sizeof(FlightTick)));
+    written = written && WriteAll(file, &ticks[0], (int)((count - firstPart)*sizeof(FlightTick)));
+
+    for (int i = 0; written && (i < FLIGHT_RECORDER_SNAPSHOTS); i++)
+    {
+        int slot = (nextSnapshot + i)%FLIGHT_RECORDER_SNAPSHOTS;
+        int size = snapshotSizes[slot];
+
+        if (size > 0) written = WriteAll(file, &size, sizeof(size)) && WriteAll(file, snapshots[slot], size);
+    }
+
+    CloseDumpFile(file);
+}
+
+static bool WriteAll(int file, const void *data, int size)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+
+    while (size > 0)
+    {
+        int result = (int)WriteDumpFile(file, bytes, size);
+        if (result <= 0) return false;
+
+        bytes += result;
+        size -= result;
+    }
+
+    return true;
+}
+
+#else
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+bool FlightRecorderInit(const char *fileName)
+{
+    (void)fileName;
+
+    return false;
+}
+
+void FlightRecorderShutdown(void)
+{
+}
+
+void FlightRecorderTick(const GameState *game, unsigned int input, float frameTime)
+{
+    (void)game;
+    (void)input;
+    (void)frameTime;
+}
+
+#endif // FLIGHT_RECORDER_SIGNALS
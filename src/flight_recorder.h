@@ -0,0 +1,91 @@
+/*******************************************************************************************
+*
+*   flight_recorder - Last seconds of game input and state, dumped to a file on crash
+*
+*   Always running: every tick records the sampled input, tick delta time and a few game
+*   counters into a ring of FLIGHT_RECORDER_TICKS entries, and every FLIGHT_RECORDER_SNAPSHOT_INTERVAL
+*   ticks a full game snapshot (see snapshot.h) goes into a small ring of snapshots.
+*   Recording is a struct copy per tick plus a snapshot per second, a few microseconds.
+*
+*   On SIGSEGV, SIGBUS, SIGILL, SIGFPE or SIGABRT (failed assert() ends up in abort()) the
+*   rings are written to the dump file using only async-signal-safe calls (open, write,
+*   close) and the signal is raised again with its default action, so core dumps and
+*   crash reporters still work. The dump file name is fixed on FlightRecorderInit().
+*
+*   A crash can be reproduced loading the newest snapshot and running the recorded ticks
+*   that follow it with their input and delta time.
+*
+*   DUMP FORMAT (native endianness):
+*       FlightDumpHeader
+*       FlightTick[tickCount]               Oldest first, last one is the tick that crashed or before
+*       { int size; unsigned char snapshot[size]; }[snapshotCount]     Oldest first
+*
+*   NOTE: A crash in the middle of recording a tick may leave that last record torn
+*
+*   NOTE: Not available on web builds, FlightRecorderInit() returns false there
+*
+********************************************************************************************/
+
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include "gameplay.h"                       // Required for: GameState
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define FLIGHT_RECORDER_MAGIC       "RFLT"
+#define FLIGHT_RECORDER_VERSION     2
+
+#define FLIGHT_RECORDER_TICKS       600     // Tick records kept, 10 seconds at 60 ticks per second
+#define FLIGHT_RECORDER_SNAPSHOT_INTERVAL 60    // Ticks between full snapshots
+#define FLIGHT_RECORDER_SNAPSHOTS   (FLIGHT_RECORDER_TICKS/FLIGHT_RECORDER_SNAPSHOT_INTERVAL + 1)
+
+// Input bits recorded per tick, same as gameplay ones (see GameReadInput())
+#define FLIGHT_INPUT_LEFT           GAME_INPUT_LEFT
+#define FLIGHT_INPUT_RIGHT          GAME_INPUT_RIGHT
+#define FLIGHT_INPUT_THRUST         GAME_INPUT_THRUST
+#define FLIGHT_INPUT_SHOOT          GAME_INPUT_SHOOT
+#define FLIGHT_INPUT_BEAM           GAME_INPUT_BEAM
+#define FLIGHT_INPUT_RESTART        GAME_INPUT_RESTART
+#define FLIGHT_INPUT_DEBUG          GAME_INPUT_DEBUG
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    unsigned int tick;                      // GameState.simTick after the tick
+    unsigned int input;                     // FLIGHT_INPUT_* bits
+    float frameTime;                        // Tick delta time
+    int currentAsteroids;
+    int liveAsteroids;
+    int lives;
+    int asteroidScore;
+    float beamCharge;
+    unsigned long long stateHash;           // GameState.stateHash after the tick, first mismatch on replay is the desync
+} FlightTick;
+
+typedef struct {
+    char magic[4];                          // FLIGHT_RECORDER_MAGIC
+    unsigned int version;                   // FLIGHT_RECORDER_VERSION
+    int signal;                             // Signal that triggered the dump
+    unsigned int tickCount;                 // FlightTick records following the header
+    unsigned int snapshotCount;             // Snapshots following the tick records
+} FlightDumpHeader;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool FlightRecorderInit(const char *fileName);                          // Install crash handlers, dump goes to fileName
+void FlightRecorderShutdown(void);                                      // Restore default crash handlers
+void FlightRecorderTick(const GameState *game, unsigned int input, float frameTime);   // Record a tick, call after every update
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // FLIGHT_RECORDER_H
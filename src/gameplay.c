@@ -0,0 +1,941 @@
+/*******************************************************************************************
+*
+*   gameplay - Asteroids game rules, simulation and world rendering
+*
+*   NOTE: Built into the executable, or as a shared library with GAMEPLAY_RELOAD (CMake),
+*   in that case raylib and sfx symbols are resolved from the host executable
+*
+********************************************************************************************/
+
+#include "gameplay.h"
+
+#include <stdlib.h>                         // Required for: abs()
+#include <string.h>                         // Required for: memcpy(), memset()
+
+#include "raymath.h"                        // Required for: Normalize(), Clamp()
+#include "sfx.h"                            // Required for: SfxPlay(), SfxPlayEx()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+// Gameplay tuning, picked up without restarting when the gameplay module is reloaded
+#define PLAYER_ROTATION_SPEED       200.f   // Degrees per second
+#define PLAYER_SPEED                100.f   // Pixels per second at full thrust
+#define PLAYER_THRUST               0.04f   // Acceleration gained per tick holding thrust
+#define SHOT_SPEED                  250.f
+#define BEAM_SPEED                  200.f
+#define BEAM_RADIUS                 100.f   // Detonated super beam radius, must fit in COLLISION_QUERY_RADIUS
+#define BEAM_CHARGE_MAX             100.f
+#define BEAM_CHARGE_PER_KILL        10.f
+#define SPAWN_INVINCIBILITY         2.f     // Seconds after respawn
+#define COLLISION_QUERY_RADIUS      128     // Pixels around a point gathered for collisions, super beam radius plus biggest asteroid radius
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static bool hasActiveAsteroids(GameState *game);
+static void UpdatePlayer(GameState *game, unsigned int input, bool playSounds);
+static void UpdateShots(GameState *game);
+static SimValue GetTickTime(void);
+static int GetGameRandomValue(GameState *game, int min, int max);
+static void WorldBatchReserve(GameState *game, int vertexCount);
+static Rectangle GetWorldViewRect(GameState *game);
+static bool IsCircleInView(Vector2 center, float radius, Rectangle view);
+static void CullAsteroids(GameState *game, Rectangle view);
+static int GetChunkIndex(SimVector2 position);
+static void ChunkLink(GameState *game, int asteroid, int chunk);
+static void ChunkUnlink(GameState *game, int asteroid);
+static int SpawnAsteroid(GameState *game, SimVector2 position, int type);
+static void KillAsteroid(GameState *game, int asteroid);
+static void UpdateAsteroidChunks(GameState *game);
+static int GatherNearbyAsteroids(GameState *game, SimVector2 position, int *indices);
+static int GetChunkRange(int from, int to, int worldSize, int chunkCount, int *chunks);
+static bool CheckCollisionCirclesWrapped(SimVector2 center1, SimValue radius1, SimVector2 center2, SimValue radius2);
+static void DrawWorldEntities(GameState *game, Rectangle view);
+static float GetSoundPan(GameState *game, Vector2 position);
+static unsigned long long HashMix(unsigned long long hash, unsigned int value);
+static unsigned long long HashEntity(unsigned long long hash, const sEntity *entity);
+static void UpdateAsteroidHash(GameState *game, int asteroid);
+static unsigned long long HashGameState(GameState *game);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+const GameplayApi *GetGameplayApi(void)
+{
+    static const GameplayApi api = { GAMEPLAY_API_VERSION, sizeof(GameState), GameReset, GameReadInput, GameStep, GameStepPlayer, GameRender };
+
+    return &api;
+}
+
+unsigned int GameReadInput(void)
+{
+    unsigned int input = 0;
+
+    if (IsKeyDown(KEY_A)) input |= GAME_INPUT_LEFT;
+    if (IsKeyDown(KEY_D)) input |= GAME_INPUT_RIGHT;
+    if (IsKeyDown(KEY_W)) input |= GAME_INPUT_THRUST;
+    if (IsKeyPressed(KEY_SPACE)) input |= GAME_INPUT_SHOOT;
+    if (IsKeyPressed(KEY_B)) input |= GAME_INPUT_BEAM;
+    if (IsKeyPressed(KEY_R)) input |= GAME_INPUT_RESTART;
+    if (IsKeyPressed(KEY_F1)) input |= GAME_INPUT_DEBUG;
+
+    return input;
+}
+
+void GameUpdate(GameState *game) {
+    GameStep(game, GameReadInput());
+}
+
+void GameStep(GameState *game, unsigned int input) {
+    if (game->hashRebuild) {
+        memset(game->asteroidHashes, 0, sizeof(game->asteroidHashes));
+        game->asteroidsHash = 0;
+        for (int i = 0; i < MAX_ASTEROIDS; i++) UpdateAsteroidHash(game, i);
+        game->hashRebuild = false;
+    }
+
+if (!game->isGameOver) {
+    UpdatePlayer(game, input, !game->silent);
+
+    //
+    if ((input & GAME_INPUT_BEAM) && !game->sSuperBeam.active && game->beamCharge >= SIM(BEAM_CHARGE_MAX)) {
+        game->sSuperBeam.active = true;
+        game->sSuperBeam.position = game->sPlayer.position;
+        game->sSuperBeam.rotation = game->sPlayer.rotation;
+        game->sSuperBeam.acceleration = SIM(1.0f);
+        game->sSuperBeam.speed.x = SIM_MUL(SIM_COS_DEG(game->sPlayer.rotation), SIM(BEAM_SPEED));
+        game->sSuperBeam.speed.y = SIM_MUL(SIM_SIN_DEG(game->sPlayer.rotation), SIM(BEAM_SPEED));
+        game->beamCharge = 0;
+    }
+
+    //Tracks delay to superbeam is active and changes to active
+    if (game->sSuperBeam.active && game->preDetonation) {
+        game->beamDelay -= GetTickTime();
+    }
+    if (game->sSuperBeam.active && game->beamDelay < 0) {
+        game->preDetonation = false;
+    }
+
+
+    //Update SuperBeam
+    if (game->sSuperBeam.active) {
+        game->sSuperBeam.position.x += SIM_MUL(SIM_MUL(game->sSuperBeam.speed.x, game->sSuperBeam.acceleration), GetTickTime());
+        game->sSuperBeam.position.y += SIM_MUL(SIM_MUL(game->sSuperBeam.speed.y, game->sSuperBeam.acceleration), GetTickTime());
+
+        // Beam is not wrapped, it is gone once it leaves the world and can be fired again when charged
+        // NOTE: Kept flying, fixed point position would overflow after a few minutes
+        if ((game->sSuperBeam.position.x < 0) || (game->sSuperBeam.position.x >= SIM_FROM_INT(WORLD_WIDTH)) ||
+            (game->sSuperBeam.position.y < 0) || (game->sSuperBeam.position.y >= SIM_FROM_INT(WORLD_HEIGHT))) {
+            game->sSuperBeam.active = false;
+            game->preDetonation = true;
+            game->beamDelay = SIM(1.0f);
+        }
+    }
+
+
+
+
+    //Update asteroids, only chunks near the camera
+    game->simTick++;
+    UpdateAsteroidChunks(game);
+
+    //update Shots
+    UpdateShots(game);
+
+    //Update Live Counter.
+
+
+
+    //Collision between shots and asteroids
+    int nearby[MAX_ASTEROIDS];
+
+    for (int i = 0; i < MAX_SHOTS; i++) {
+        if (game->sShots[i].active ) {
+            int nearbyCount = GatherNearbyAsteroids(game, game->sShots[i].position, nearby);
+
+            for (int n = 0; n < nearbyCount; n++) {
+                int j = nearby[n];
+                SimValue texWidth = SIM_FROM_INT((int)atlasRects[game->sAsteroids[j].type].width);
+                if (CheckCollisionCirclesWrapped(game->sShots[i].position,SIM(2.0f),game->sAsteroids[j].position,texWidth/2)){
+                    //Collision
+                    sEntity destroyed = game->sAsteroids[j];
+                    KillAsteroid(game, j);
+                    game->sShots[i].active = false;
+                    game->asteroidScore++;
+                    game->currentAsteroids--;
+                    game->beamCharge += SIM(BEAM_CHARGE_PER_KILL);
+                    CheckAsteroidType(game, &destroyed);
+                    if (!game->silent) SfxPlayEx(SOUND_EXPLOSION, 1.0f, GetSoundPan(game, SIM_TO_VECTOR2(destroyed.position)));
+                    break;
+
+                }
+            }
+        }
+    }
+    //Check Collison for Super Beam, active beam is always in the world
+    if (game->sSuperBeam.active && !game->preDetonation) {
+        int nearbyCount = GatherNearbyAsteroids(game, game->sSuperBeam.position, nearby);
+
+        for (int n = 0; n < nearbyCount; n++) {
+            int i = nearby[n];
+            SimValue roidTexWidth = SIM_FROM_INT((int)atlasRects[game->sAsteroids[i].type].width);
+
+            if (CheckCollisionCirclesWrapped(game->sSuperBeam.position,SIM(BEAM_RADIUS),game->sAsteroids[i].position,roidTexWidth/2)) {
+                KillAsteroid(game, i);
+                game->asteroidScore++;
+                game->currentAsteroids--;
+                if (!game->silent) SfxPlayEx(SOUND_EXPLOSION, 1.0f, GetSoundPan(game, SIM_TO_VECTOR2(game->sSuperBeam.position)));
+
+                break;
+            }
+        }
+    }
+
+    //Chcek for collision of player with asteroids if not just spawned in
+    if (game->spawnInvincibility <0) {
+        int nearbyCount = GatherNearbyAsteroids(game, game->sPlayer.position, nearby);
+
+        // Need to add a switch statement for pulling radius image size are all the same so they have the same hit box
+        for (int n = 0; n < nearbyCount; ++n) {
+            int i = nearby[n];
+            SimValue playerTexWidth = SIM_FROM_INT((int)atlasRects[game->sPlayer.type].width) / 4; //Player divided by 4 because render texture is already divided by 4
+            SimValue roidTexWidth = SIM_FROM_INT((int)atlasRects[game->sAsteroids[i].type].width);
+
+            switch (game->sAsteroids[i].type) {
+                case TYPE_ASTEROID_SMALL:
+                    roidTexWidth = roidTexWidth/5;
+                break;
+                case TYPE_ASTEROID_MED:
+                    roidTexWidth = roidTexWidth/4;
+                case TYPE_ASTEROID_LARGE:
+                    roidTexWidth = roidTexWidth/3;
+
+                break;
+                default: ;
+            }
+
+            if (CheckCollisionCirclesWrapped(game->sPlayer.position,playerTexWidth,game->sAsteroids[i].position,roidTexWidth)) {
+                PlayerDeath(game);
+                break;              // Player is invincible after respawn
+            }
+        }
+    }
+
+    if (game->beamCharge <= SIM(BEAM_CHARGE_MAX)) {
+        game->beamCharge += GetTickTime();
+    }
+
+    if (game->spawnInvincibility> 0) {
+        game->spawnInvincibility -= GetTickTime();
+    }
+    if (hasActiveAsteroids(game) == false) {
+        game->isGameOver = true;
+    }
+
+    // Camera follows the player, centered on the render target
+    game->camera.target = SIM_TO_VECTOR2(game->sPlayer.position);
+    game->camera.offset = (Vector2){ game->viewSize.x/2.0f, game->viewSize.y/2.0f };
+    game->camera.zoom = game->viewScale;
+}
+
+    if (input & GAME_INPUT_DEBUG) game->showDebug = !game->showDebug;
+
+    if (game->isGameOver && (input & GAME_INPUT_RESTART)) {
+        GameReset(game);
+        game->isGameOver = false;
+    }
+
+    game->stateHash = HashGameState(game);
+
+}
+
+// Player ship and shots only, world and collisions are left as they are
+void GameStepPlayer(GameState *game, unsigned int input, bool replay) {
+    if (game->isGameOver) return;
+
+    UpdatePlayer(game, input, !replay);
+    UpdateShots(game);
+
+    game->camera.target = SIM_TO_VECTOR2(game->sPlayer.position);
+}
+
+void GameRender(GameState *game) {
+    // World sprites go to their own batch, sized from the entity caps so it never
+    // flushes mid-frame, HUD elements keep using the default batch drawn on top
+    // NOTE: World batch must be submitted before EndMode2D(), camera transform is applied on submission
+    BeginMode2D(game->camera);
+    rlSetRenderBatchActive(&game->worldBatch);
+
+    //draw the player
+    WorldBatchReserve(game, 4);
+    if (game->spawnInvincibility>0) {
+        DrawTexturePro(game->atlas,
+                atlasRects[TEXTURE_PLAYER],
+                (Rectangle) { SIM_TO_FLOAT(game->sPlayer.position.x), SIM_TO_FLOAT(game->sPlayer.position.y), atlasRects[TEXTURE_PLAYER].width/2, atlasRects[TEXTURE_PLAYER].height/2 },
+                (Vector2) {atlasRects[TEXTURE_PLAYER].width/4,atlasRects[TEXTURE_PLAYER].height/4},
+                SIM_TO_FLOAT(game->sPlayer.rotation) +90,
+                GRAY);
+
+    }else {
+
+        DrawTexturePro(game->atlas,
+        atlasRects[TEXTURE_PLAYER],
+        (Rectangle) { SIM_TO_FLOAT(game->sPlayer.position.x), SIM_TO_FLOAT(game->sPlayer.position.y), atlasRects[TEXTURE_PLAYER].width/2, atlasRects[TEXTURE_PLAYER].height/2 },
+        (Vector2) {atlasRects[TEXTURE_PLAYER].width/4,atlasRects[TEXTURE_PLAYER].height/4},
+        SIM_TO_FLOAT(game->sPlayer.rotation) +90,
+        RAYWHITE);
+
+    }
+
+    // The world wraps around, view parts out of the world show the opposite side,
+    // draw every wrapped copy of the world that overlaps the view
+    Rectangle view = GetWorldViewRect(game);
+    game->cullStats = (CullStats){ 0 };
+    memset(game->asteroidDrawn, 0, sizeof(game->asteroidDrawn));
+    memset(game->shotDrawn, 0, sizeof(game->shotDrawn));
+
+    for (int oy = -1; oy <= 1; oy++) {
+        for (int ox = -1; ox <= 1; ox++) {
+            Vector2 offset = { (float)(ox*WORLD_WIDTH), (float)(oy*WORLD_HEIGHT) };
+            Rectangle wrappedView = { view.x - offset.x, view.y - offset.y, view.width, view.height };
+
+            if (!CheckCollisionRecs(wrappedView, (Rectangle){ -CHUNK_SIZE, -CHUNK_SIZE, WORLD_WIDTH + 2*CHUNK_SIZE, WORLD_HEIGHT + 2*CHUNK_SIZE })) continue;
+
+            rlPushMatrix();
+                rlTranslatef(offset.x, offset.y, 0.0f);
+                DrawWorldEntities(game, wrappedView);
+            rlPopMatrix();
+        }
+    }
+
+    // Entities not drawn in any wrapped copy
+    for (int i = 0; i < MAX_ASTEROIDS; i++) if (game->sAsteroids[i].active && !game->asteroidDrawn[i]) game->cullStats.culled++;
+    for (int i = 0; i < MAX_SHOTS; i++) if (game->sShots[i].active && !game->shotDrawn[i]) game->cullStats.culled++;
+
+    // Gather world batch stats before it is submitted
+    game->worldBatchStats.drawCalls = game->worldBatch.drawCounter;
+    game->worldBatchStats.vertices = 0;
+    for (int i = 0; i < game->worldBatch.drawCounter; i++) game->worldBatchStats.vertices += game->worldBatch.draws[i].vertexCount;
+    game->worldBatchStats.submissions = game->worldBatchStats.flushes + 1;
+
+    rlSetRenderBatchActive(NULL);           // Submit world batch, back to default batch for HUD
+    game->worldBatchStats.flushes = 0;
+    EndMode2D();
+
+    // HUD is laid out in screen coordinates, scaled to the render target size
+    BeginMode2D((Camera2D){ .zoom = game->viewScale });
+
+    //Draw Lives UI
+
+    for (int i = 0; i < MAX_LIVES; i++) {
+        if (game->sLives[i].active) {
+            DrawTexturePro(game->atlas,
+        atlasRects[TEXTURE_PLAYER],
+        (Rectangle) { SIM_TO_FLOAT(game->sLives[i].position.x),SIM_TO_FLOAT(game->sLives[i].position.y), atlasRects[TEXTURE_PLAYER].width/2, atlasRects[TEXTURE_PLAYER].height/2 },
+        (Vector2) {atlasRects[TEXTURE_PLAYER].width/4,atlasRects[TEXTURE_PLAYER].height/4},
+        SIM_TO_FLOAT(game->sLives[i].rotation),
+        RAYWHITE);
+        }
+    }
+
+    //Draw BeamCharge Bar
+    float beamChargeNorm = Normalize(SIM_TO_FLOAT(game->beamCharge),0.f,BEAM_CHARGE_MAX);
+    if (beamChargeNorm < 1.f) {
+        DrawRectangle(400,20,100*beamChargeNorm,30, YELLOW);
+    } else {
+        DrawRectangle(400,20,100,30, GREEN); // when fully charged turn green.
+    }
+
+    DrawRectangleLines(400,20,100,30, WHITE);
+
+    //draw basic UI
+
+    if (game->isGameOver) {
+        DrawText(TextFormat("Game Over"),SCREEN_WIDTH/2-50,SCREEN_HEIGHT/2 ,30,YELLOW);
+        DrawText(TextFormat("Press R to Restart"),SCREEN_WIDTH/2 - 50,SCREEN_HEIGHT/2 + 30 ,20,YELLOW);
+
+    }
+
+    EndMode2D();
+}
+void GameReset(GameState *game) {
+    game->sPlayer.position = (SimVector2) { SIM_FROM_INT(WORLD_WIDTH/2), SIM_FROM_INT(WORLD_HEIGHT/2)};
+    game->sPlayer.speed = (SimVector2) { 0, 0};
+    game->sPlayer.rotation = 0;
+    game->sPlayer.acceleration = 0;
+    game->sPlayer.type = TYPE_PLAYER;
+    game->asteroidScore = 0;
+    game->currentAsteroids = MAX_ASTEROIDS;
+    game->beamDelay = SIM(1.0f);
+    game->preDetonation = true;
+    game->lives = MAX_LIVES;
+    game->beamCharge = 0;
+
+    SimValue livesUIX = SIM_FROM_INT(30);
+
+    for (int i = 0; i < game->lives; i++) {
+        game->sLives[i].active = true;
+        game->sLives[i].position.x = livesUIX;
+        game->sLives[i].position.y = SIM_FROM_INT(50);
+        livesUIX+= SIM_FROM_INT(40);
+        game->sLives[i].type = TYPE_PLAYER;
+
+    }
+
+
+    for (int i = 0; i < MAX_CHUNKS; i++) {
+        game->chunkFirst[i] = -1;
+        game->chunkLastTick[i] = game->simTick;
+    }
+
+    for (int i = 0; i < MAX_ASTEROIDS; i++) {
+        game->sAsteroids[i].active = false;
+    }
+    game->liveAsteroids = 0;
+    memset(game->asteroidHashes, 0, sizeof(game->asteroidHashes));
+    game->asteroidsHash = 0;
+    game->hashRebuild = false;
+
+    for (int i = 0; i < SPAWN_ASTEROIDS; i++) {
+        SimVector2 position = (SimVector2) {SIM_FROM_INT(GetGameRandomValue(game, 0,WORLD_WIDTH)), SIM_FROM_INT(GetGameRandomValue(game, 0,WORLD_HEIGHT))};
+        SpawnAsteroid(game, position, GetGameRandomValue(game, TYPE_ASTEROID_SMALL,TYPE_ASTEROID_LARGE));
+    }
+
+    for (int i = 0; i < MAX_SHOTS; i++) {
+        game->sShots[i].active = false;
+    }
+
+    game->sSuperBeam.active = false;
+
+    game->camera.target = SIM_TO_VECTOR2(game->sPlayer.position);
+    game->camera.zoom = game->viewScale;
+
+    game->stateHash = HashGameState(game);
+}
+
+void CheckAsteroidType(GameState *game, sEntity *entity)
+ {
+    //take asteroid check type and spawn new small asteroid if passed asteroid is bigge than small
+    // spawn asteroids from the player in random directions .
+;
+        // check type of collision
+    if (entity->type == TYPE_ASTEROID_MED ) {
+        //Seach for non active asteroid and spawn on entity death
+        SpawnAsteroid(game, entity->position, TYPE_ASTEROID_SMALL);
+    }
+
+    if (entity->type == TYPE_ASTEROID_LARGE ) {
+        for (int i = 0; i < 2; i++) {
+            SpawnAsteroid(game, entity->position, TYPE_ASTEROID_SMALL);
+        }
+    }
+}
+
+void PlayerDeath(GameState *game) {
+    game->lives--;
+    game->sLives[game->lives].active = false;
+
+    if (game->lives <= 0) {
+        game->isGameOver = true;
+
+    } else {
+        game->sPlayer.position = (SimVector2) { SIM_FROM_INT(WORLD_WIDTH/2), SIM_FROM_INT(WORLD_HEIGHT/2)};
+        game->sPlayer.speed = (SimVector2) { 0, 0};
+        game->sPlayer.rotation = 0;
+        game->sPlayer.acceleration = 0;
+        game->sPlayer.type = TYPE_PLAYER;
+        game->spawnInvincibility = SIM(SPAWN_INVINCIBILITY);
+    }
+
+
+
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+static bool hasActiveAsteroids(GameState *game) {
+    return (game->liveAsteroids > 0);
+}
+
+// Rotate, thrust and move the player ship, spawn shots
+static void UpdatePlayer(GameState *game, unsigned int input, bool playSounds) {
+    if (input & GAME_INPUT_LEFT) {
+        game->sPlayer.rotation -= SIM_MUL(SIM(PLAYER_ROTATION_SPEED), GetTickTime());
+    }
+
+    if (input & GAME_INPUT_RIGHT) {
+        game->sPlayer.rotation +=  SIM_MUL(SIM(PLAYER_ROTATION_SPEED), GetTickTime());
+    }
+
+    // Keep rotation in [0, 360), fixed point angles have a limited range
+    if (game->sPlayer.rotation < 0) {
+        game->sPlayer.rotation += SIM_FROM_INT(360);
+    } else if (game->sPlayer.rotation >= SIM_FROM_INT(360)) {
+        game->sPlayer.rotation -= SIM_FROM_INT(360);
+    }
+
+    game->sPlayer.speed.x = SIM_MUL(SIM_COS_DEG(game->sPlayer.rotation), SIM(PLAYER_SPEED));
+    game->sPlayer.speed.y = SIM_MUL(SIM_SIN_DEG(game->sPlayer.rotation), SIM(PLAYER_SPEED));
+
+    if (input & GAME_INPUT_THRUST) {
+        if (game->sPlayer.acceleration <SIM(1.0f)) {
+            game->sPlayer.acceleration += SIM(PLAYER_THRUST);
+        }
+
+    }
+    game->sPlayer.position.x += SIM_MUL(SIM_MUL(game->sPlayer.speed.x, game->sPlayer.acceleration), GetTickTime());
+    game->sPlayer.position.y += SIM_MUL(SIM_MUL(game->sPlayer.speed.y, game->sPlayer.acceleration), GetTickTime());
+
+
+    // Player Wrapping around the world.
+    if (game->sPlayer.position.x >SIM_FROM_INT(WORLD_WIDTH)) {
+        game->sPlayer.position.x = game->sPlayer.position.x - SIM_FROM_INT(WORLD_WIDTH);
+    } else if (game->sPlayer.position.x <0) {
+        game->sPlayer.position.x = SIM_FROM_INT(WORLD_WIDTH);
+    }
+    if (game->sPlayer.position.y >SIM_FROM_INT(WORLD_HEIGHT)) {
+        game->sPlayer.position.y = game->sPlayer.position.y - SIM_FROM_INT(WORLD_HEIGHT);
+    }else if (game->sPlayer.position.y <0) {
+        game->sPlayer.position.y = SIM_FROM_INT(WORLD_HEIGHT);
+    }
+
+    //Spawn Shots
+    if (input & GAME_INPUT_SHOOT) {
+        for (int i = 0; i < MAX_SHOTS; i++) {
+            if (!game->sShots[i].active) {
+                game->sShots[i].active = true;
+                game->sShots[i].position = game->sPlayer.position;
+                game->sShots[i].rotation = game->sPlayer.rotation;
+                game->sShots[i].acceleration = SIM(1.0f);
+                game->sShots[i].lifetime = SIM(SHOT_LIFETIME);
+                game->sShots[i].speed.x = SIM_MUL(SIM_COS_DEG(game->sPlayer.rotation), SIM(SHOT_SPEED));
+                game->sShots[i].speed.y = SIM_MUL(SIM_SIN_DEG(game->sPlayer.rotation), SIM(SHOT_SPEED));
+
+                if (playSounds) SfxPlay(SOUND_SHOOT);
+
+                break;
+            }
+        }
+    }
+}
+
+// Move shots, expire them once their lifetime is over
+static void UpdateShots(GameState *game) {
+    for (int i = 0; i < MAX_SHOTS; i++) {
+        if (game->sShots[i].active) {
+            game->sShots[i].position.x += SIM_MUL(SIM_MUL(game->sShots[i].speed.x, game->sShots[i].acceleration), GetTickTime());
+            game->sShots[i].position.y += SIM_MUL(SIM_MUL(game->sShots[i].speed.y, game->sShots[i].acceleration), GetTickTime());
+
+            if (game->sShots[i].position.x >SIM_FROM_INT(WORLD_WIDTH)) {
+                game->sShots[i].position.x -= SIM_FROM_INT(WORLD_WIDTH);
+            } else if (game->sShots[i].position.x <0) {
+                game->sShots[i].position.x += SIM_FROM_INT(WORLD_WIDTH);
+            }
+
+            if (game->sShots[i].position.y >SIM_FROM_INT(WORLD_HEIGHT)) {
+                game->sShots[i].position.y -= SIM_FROM_INT(WORLD_HEIGHT);
+            } else if (game->sShots[i].position.y <0) {
+                game->sShots[i].position.y += SIM_FROM_INT(WORLD_HEIGHT);
+            }
+
+            game->sShots[i].lifetime -= GetTickTime();
+            if (game->sShots[i].lifetime <= 0) {
+                game->sShots[i].active = false;
+            }
+
+        }
+    }
+}
+
+// Get simulation time step, fixed with SUPPORT_FIXED_POINT so results do not depend on frame timing
+static SimValue GetTickTime(void)
+{
+#if defined(SUPPORT_FIXED_POINT)
+    return SIM(1.0f/GAME_TICK_RATE);
+#else
+    return GetFrameTime();
+#endif
+}
+
+// Get random value in [min, max] from the game state generator (xorshift32)
+// NOTE: Generator state is part of GameState, so restoring a snapshot also restores the sequence
+static int GetGameRandomValue(GameState *game, int min, int max)
+{
+    unsigned int x = game->rngState;
+
+    if (x == 0) x = 0x9e3779b9;             // Zero is a fixed point of xorshift
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    game->rngState = x;
+
+    return min + (int)(x%(unsigned int)(max - min + 1));
+}
+
+// Make room for the next world draw, counting any flush it forces
+// NOTE: Flushing here, before the draw, is what rlgl would do implicitly, this way it can be counted
+static void WorldBatchReserve(GameState *game, int vertexCount)
+{
+    if (rlCheckRenderBatchLimit(vertexCount)) game->worldBatchStats.flushes++;
+}
+
+// Get the world area visible through the render target
+// NOTE: View can extend out of world bounds, the world wraps around
+static Rectangle GetWorldViewRect(GameState *game)
+{
+    return (Rectangle){ game->camera.target.x - game->camera.offset.x/game->camera.zoom, game->camera.target.y - game->camera.offset.y/game->camera.zoom,
+                        game->viewSize.x/game->camera.zoom, game->viewSize.y/game->camera.zoom };
+}
+
+// Check if a bounding circle overlaps the view rect
+static bool IsCircleInView(Vector2 center, float radius, Rectangle view)
+{
+    return ((center.x + radius) >= view.x) && ((center.x - radius) <= (view.x + view.width)) &&
+           ((center.y + radius) >= view.y) && ((center.y - radius) <= (view.y + view.height));
+}
+
+// Fill visible asteroids list, only chunks overlapping the view are checked
+// NOTE: Bounding radius is the sprite half diagonal so it holds for any rotation
+static void CullAsteroids(GameState *game, Rectangle view)
+{
+    game->visibleAsteroidsCount = 0;
+
+    int minX = (int)floorf((view.x - CHUNK_SIZE/2)/CHUNK_SIZE);
+    int minY = (int)floorf((view.y - CHUNK_SIZE/2)/CHUNK_SIZE);
+    int maxX = (int)floorf((view.x + view.width + CHUNK_SIZE/2)/CHUNK_SIZE);
+    int maxY = (int)floorf((view.y + view.height + CHUNK_SIZE/2)/CHUNK_SIZE);
+
+    if (minX < 0) minX = 0;
+    if (minY < 0) minY = 0;
+    if (maxX > (CHUNKS_X - 1)) maxX = CHUNKS_X - 1;
+    if (maxY > (CHUNKS_Y - 1)) maxY = CHUNKS_Y - 1;
+
+    for (int cy = minY; cy <= maxY; cy++) {
+        for (int cx = minX; cx <= maxX; cx++) {
+            for (int i = game->chunkFirst[cy*CHUNKS_X + cx]; i != -1; i = game->asteroidNext[i]) {
+                Rectangle rec = atlasRects[game->sAsteroids[i].type];
+                float radius = 0.5f*sqrtf(rec.width*rec.width + rec.height*rec.height);
+
+                if (IsCircleInView(SIM_TO_VECTOR2(game->sAsteroids[i].position), radius, view)) {
+                    game->visibleAsteroids[game->visibleAsteroidsCount++] = i;
+
+                    // Asteroids near the seam are drawn in more than one wrapped copy
+                    if (!game->asteroidDrawn[i]) game->cullStats.drawn++;
+                    game->asteroidDrawn[i] = true;
+                }
+            }
+        }
+    }
+}
+
+// Draw asteroids, shots and beam visible in view
+static void DrawWorldEntities(GameState *game, Rectangle view)
+{
+    //draw asteroids, only the ones that passed view culling
+    CullAsteroids(game, view);
+
+    for (int v = 0; v < game->visibleAsteroidsCount; v++) {
+        int i = game->visibleAsteroids[v];
+        WorldBatchReserve(game, 4);
+        DrawTexturePro(game->atlas,
+            atlasRects[game->sAsteroids[i].type],
+            (Rectangle){SIM_TO_FLOAT(game->sAsteroids[i].position.x),SIM_TO_FLOAT(game->sAsteroids[i].position.y),atlasRects[game->sAsteroids[i].type].width,atlasRects[game->sAsteroids[i].type].height },
+            (Vector2){atlasRects[game->sAsteroids[i].type].width/2,atlasRects[game->sAsteroids[i].type].height/2},
+            SIM_TO_FLOAT(game->sAsteroids[i].rotation),
+            RAYWHITE);
+    }
+
+    //draw shots
+    for (int i = 0; i < MAX_SHOTS; i++) {
+        if (game->sShots[i].active && IsCircleInView(SIM_TO_VECTOR2(game->sShots[i].position), 2.f, view)) {
+            WorldBatchReserve(game, WORLD_CIRCLE_MAX_VERTICES);
+            DrawCircle(SIM_TO_FLOAT(game->sShots[i].position.x), SIM_TO_FLOAT(game->sShots[i].position.y), 2.f, RAYWHITE);
+
+            if (!game->shotDrawn[i]) game->cullStats.drawn++;
+            game->shotDrawn[i] = true;
+        }
+    }
+
+    //Draws Pre active super beam
+    if (game->sSuperBeam.active && game->preDetonation && IsCircleInView(SIM_TO_VECTOR2(game->sSuperBeam.position), 10.f, view)) {
+        WorldBatchReserve(game, WORLD_CIRCLE_MAX_VERTICES);
+        DrawCircle(SIM_TO_FLOAT(game->sSuperBeam.position.x), SIM_TO_FLOAT(game->sSuperBeam.position.y),10.f, RAYWHITE);
+    }
+
+    //Draws active  Beam
+    if (game->sSuperBeam.active && !game->preDetonation && IsCircleInView(SIM_TO_VECTOR2(game->sSuperBeam.position), BEAM_RADIUS, view)) {
+        WorldBatchReserve(game, WORLD_CIRCLE_MAX_VERTICES);
+        DrawCircle(SIM_TO_FLOAT(game->sSuperBeam.position.x), SIM_TO_FLOAT(game->sSuperBeam.position.y), BEAM_RADIUS, RAYWHITE);
+        //DrawRectanglePro((Rectangle){game->sPlayer.position.x, game->sPlayer.position.y,250,400},(Vector2){250/2,0},game->sPlayer.rotation-90,RAYWHITE);
+    }
+}
+
+// Get chunk containing a world position
+static int GetChunkIndex(SimVector2 position)
+{
+    int cx = SIM_TO_INT(position.x)/CHUNK_SIZE;
+    int cy = SIM_TO_INT(position.y)/CHUNK_SIZE;
+
+    if (cx < 0) cx = 0;
+    else if (cx > (CHUNKS_X - 1)) cx = CHUNKS_X - 1;
+    if (cy < 0) cy = 0;
+    else if (cy > (CHUNKS_Y - 1)) cy = CHUNKS_Y - 1;
+
+    return cy*CHUNKS_X + cx;
+}
+
+// Insert asteroid at the head of chunk list
+static void ChunkLink(GameState *game, int asteroid, int chunk)
+{
+    game->asteroidChunk[asteroid] = chunk;
+    game->asteroidPrev[asteroid] = -1;
+    game->asteroidNext[asteroid] = game->chunkFirst[chunk];
+    if (game->chunkFirst[chunk] != -1) game->asteroidPrev[game->chunkFirst[chunk]] = asteroid;
+    game->chunkFirst[chunk] = asteroid;
+}
+
+// Remove asteroid from its chunk list
+static void ChunkUnlink(GameState *game, int asteroid)
+{
+    if (game->asteroidPrev[asteroid] != -1) game->asteroidNext[game->asteroidPrev[asteroid]] = game->asteroidNext[asteroid];
+    else game->chunkFirst[game->asteroidChunk[asteroid]] = game->asteroidNext[asteroid];
+    if (game->asteroidNext[asteroid] != -1) game->asteroidPrev[game->asteroidNext[asteroid]] = game->asteroidPrev[asteroid];
+}
+
+// Activate a free asteroid slot with random direction and speed, returns -1 if pool is full
+static int SpawnAsteroid(GameState *game, SimVector2 position, int type)
+{
+    for (int i = 0; i < MAX_ASTEROIDS; i++) {
+        if (!game->sAsteroids[i].active) {
+            game->sAsteroids[i].rotation = SIM_FROM_INT(GetGameRandomValue(game, 0, 360));
+            game->sAsteroids[i].position = position;
+            game->sAsteroids[i].type = type;
+            game->sAsteroids[i].speed = (SimVector2) { SIM_FROM_INT(GetGameRandomValue(game, 1,2)),SIM_FROM_INT(GetGameRandomValue(game, 1,2))};
+            game->sAsteroids[i].active = true;
+            UpdateAsteroidHash(game, i);
+
+            ChunkLink(game, i, GetChunkIndex(position));
+            game->liveAsteroids++;
+
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+static void KillAsteroid(GameState *game, int asteroid)
+{
+    game->sAsteroids[asteroid].active = false;
+    UpdateAsteroidHash(game, asteroid);
+    ChunkUnlink(game, asteroid);
+    game->liveAsteroids--;
+}
+
+// Move asteroids in chunks around the camera, simulation rate drops with distance and
+// chunks out of CHUNK_REDUCED_RATE_RADIUS are frozen, so cost depends on the area near
+// the player instead of the total asteroid count
+static void UpdateAsteroidChunks(GameState *game)
+{
+    int *moved = game->movedAsteroids;
+    int movedCount = 0;
+
+    int cameraChunk = GetChunkIndex(game->sPlayer.position);     // Camera follows the player
+    int cameraX = cameraChunk%CHUNKS_X;
+    int cameraY = cameraChunk/CHUNKS_X;
+
+    game->chunkStats = (ChunkStats){ 0 };
+
+    for (int dy = -CHUNK_REDUCED_RATE_RADIUS; dy <= CHUNK_REDUCED_RATE_RADIUS; dy++) {
+        for (int dx = -CHUNK_REDUCED_RATE_RADIUS; dx <= CHUNK_REDUCED_RATE_RADIUS; dx++) {
+            int cx = ((cameraX + dx)%CHUNKS_X + CHUNKS_X)%CHUNKS_X;
+            int cy = ((cameraY + dy)%CHUNKS_Y + CHUNKS_Y)%CHUNKS_Y;
+            int chunk = cy*CHUNKS_X + cx;
+            int distance = (abs(dx) > abs(dy))? abs(dx) : abs(dy);
+
+            if (game->chunkVisitTick[chunk] == game->simTick) continue;
+
+            if (distance > CHUNK_FULL_RATE_RADIUS) {
+                // Stagger reduced rate chunks so their cost is spread across ticks
+                if (((game->simTick + chunk)%CHUNK_REDUCED_RATE_INTERVAL) != 0) continue;
+                game->chunkStats.reducedRate++;
+            } else {
+                game->chunkStats.fullRate++;
+            }
+
+            game->chunkVisitTick[chunk] = game->simTick;
+
+            // Catch up skipped ticks, chunks coming back from frozen do not jump ahead
+            unsigned int steps = game->simTick - game->chunkLastTick[chunk];
+            if (steps > CHUNK_REDUCED_RATE_INTERVAL) steps = CHUNK_REDUCED_RATE_INTERVAL;
+            game->chunkLastTick[chunk] = game->simTick;
+
+            for (int i = game->chunkFirst[chunk]; i != -1; i = game->asteroidNext[i]) {
+                game->sAsteroids[i].position.x += SIM_MUL(game->sAsteroids[i].speed.x, SIM_COS_DEG(game->sAsteroids[i].rotation)) * (int)steps;
+                game->sAsteroids[i].position.y += SIM_MUL(game->sAsteroids[i].speed.y, SIM_SIN_DEG(game->sAsteroids[i].rotation)) * (int)steps;
+
+                if (game->sAsteroids[i].position.x > SIM_FROM_INT(WORLD_WIDTH)) {
+                    game->sAsteroids[i].position.x = game->sAsteroids[i].position.x -SIM_FROM_INT(WORLD_WIDTH);
+                } else if (game->sAsteroids[i].position.x <0) {
+                    game->sAsteroids[i].position.x += SIM_FROM_INT(WORLD_WIDTH);
+                }
+
+                if (game->sAsteroids[i].position.y >SIM_FROM_INT(WORLD_HEIGHT)) {
+                    game->sAsteroids[i].position.y = game->sAsteroids[i].position.y - SIM_FROM_INT(WORLD_HEIGHT);
+                }else if (game->sAsteroids[i].position.y <0) {
+                    game->sAsteroids[i].position.y += SIM_FROM_INT(WORLD_HEIGHT);
+                }
+
+                UpdateAsteroidHash(game, i);
+
+                // Relink after the pass, so asteroids are not updated twice in one tick
+                if (GetChunkIndex(game->sAsteroids[i].position) != chunk) moved[movedCount++] = i;
+                game->chunkStats.asteroids++;
+            }
+        }
+    }
+
+    for (int i = 0; i < movedCount; i++) {
+        ChunkUnlink(game, moved[i]);
+        ChunkLink(game, moved[i], GetChunkIndex(game->sAsteroids[moved[i]].position));
+    }
+}
+
+// Get asteroids in the chunks within COLLISION_QUERY_RADIUS of a world position (broadphase), returns count
+// NOTE: Chunks are gathered by wrapped range, last chunk column and row are narrower when the world
+// size is not a multiple of CHUNK_SIZE, so chunks next to the center one are not always enough
+static int GatherNearbyAsteroids(GameState *game, SimVector2 position, int *indices)
+{
+    int columns[CHUNKS_X] = { 0 };
+    int rows[CHUNKS_Y] = { 0 };
+    int x = SIM_TO_INT(position.x);
+    int y = SIM_TO_INT(position.y);
+    int columnCount = GetChunkRange(x - COLLISION_QUERY_RADIUS, x + COLLISION_QUERY_RADIUS + 1, WORLD_WIDTH, CHUNKS_X, columns);
+    int rowCount = GetChunkRange(y - COLLISION_QUERY_RADIUS, y + COLLISION_QUERY_RADIUS + 1, WORLD_HEIGHT, CHUNKS_Y, rows);
+    int count = 0;
+
+    for (int r = 0; r < rowCount; r++) {
+        for (int c = 0; c < columnCount; c++) {
+            for (int i = game->chunkFirst[rows[r]*CHUNKS_X + columns[c]]; i != -1; i = game->asteroidNext[i]) indices[count++] = i;
+        }
+    }
+
+    return count;
+}
+
+// Get chunk columns (or rows) overlapped by a world range, the range wraps around the world, returns count
+// NOTE: Every chunk is listed once, small worlds would otherwise wrap onto the same chunk twice
+static int GetChunkRange(int from, int to, int worldSize, int chunkCount, int *chunks)
+{
+    int count = 0;
+
+    if ((to - from) >= worldSize) {
+        for (int i = 0; i < chunkCount; i++) chunks[count++] = i;
+        return count;
+    }
+
+    int length = to - from;
+    from = (from%worldSize + worldSize)%worldSize;
+    to = from + length;
+
+    int first = from/CHUNK_SIZE;
+    int last = ((to < worldSize)? to : worldSize - 1)/CHUNK_SIZE;
+    for (int i = first; i <= last; i++) chunks[count++] = i;
+
+    // Range past the world end continues from the start
+    if (to >= worldSize) {
+        last = (to - worldSize)/CHUNK_SIZE;
+        for (int i = 0; (i <= last) && (i < first); i++) chunks[count++] = i;
+    }
+
+    return count;
+}
+
+// Check collision between two circles, taking the shortest way around the wrapping world
+static bool CheckCollisionCirclesWrapped(SimVector2 center1, SimValue radius1, SimVector2 center2, SimValue radius2)
+{
+    SimValue dx = SIM_ABS(center1.x - center2.x);
+    SimValue dy = SIM_ABS(center1.y - center2.y);
+
+    if (dx > SIM_FROM_INT(WORLD_WIDTH/2)) dx = SIM_FROM_INT(WORLD_WIDTH) - dx;
+    if (dy > SIM_FROM_INT(WORLD_HEIGHT/2)) dy = SIM_FROM_INT(WORLD_HEIGHT) - dy;
+
+#if defined(SUPPORT_FIXED_POINT)
+    // Squared distances do not fit 16.16, compared as exact 64bit products
+    long long radius = (long long)radius1 + radius2;
+
+    return (((long long)dx*dx + (long long)dy*dy) <= radius*radius);
+#else
+    return ((dx*dx + dy*dy) <= (radius1 + radius2)*(radius1 + radius2));
+#endif
+}
+
+// Get stereo pan for a world position, relative to the camera (0.5 is center)
+static float GetSoundPan(GameState *game, Vector2 position)
+{
+    float dx = position.x - game->camera.target.x;
+
+    if (dx > WORLD_WIDTH/2) dx -= WORLD_WIDTH;
+    else if (dx < -WORLD_WIDTH/2) dx += WORLD_WIDTH;
+
+    return Clamp(0.5f + dx/SCREEN_WIDTH, 0.0f, 1.0f);
+}
+
+// Mix a 32bit value into a hash (splitmix64 finalizer)
+static unsigned long long HashMix(unsigned long long hash, unsigned int value)
+{
+    hash = (hash ^ value) + 0x9e3779b97f4a7c15ULL;
+    hash = (hash ^ (hash >> 30))*0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27))*0x94d049bb133111ebULL;
+
+    return hash ^ (hash >> 31);
+}
+
+// Hash entity fields, values by their bits so any change is seen
+static unsigned long long HashEntity(unsigned long long hash, const sEntity *entity)
+{
+    SimValue values[7] = { entity->position.x, entity->position.y, entity->speed.x, entity->speed.y, entity->rotation, entity->acceleration, entity->lifetime };
+    unsigned int bits[7] = { 0 };
+    memcpy(bits, values, sizeof(bits));
+
+    for (int i = 0; i < 7; i++) hash = HashMix(hash, bits[i]);
+    hash = HashMix(hash, (unsigned int)entity->type);
+
+    return HashMix(hash, entity->active? 1 : 0);
+}
+
+// Refresh asteroid contribution to the state hash, call after any change to the asteroid
+// NOTE: Contributions are summed, order does not matter and replacing one is O(1)
+static void UpdateAsteroidHash(GameState *game, int asteroid)
+{
+    unsigned long long hash = game->sAsteroids[asteroid].active? HashEntity((unsigned long long)asteroid, &game->sAsteroids[asteroid]) : 0;
+
+    game->asteroidsHash += hash - game->asteroidHashes[asteroid];
+    game->asteroidHashes[asteroid] = hash;
+}
+
+// Combine asteroids hash with everything else, a few dozen values rehashed every tick
+// NOTE: Derived state (chunk lists, chunk ticks, stats) is not hashed
+static unsigned long long HashGameState(GameState *game)
+{
+    unsigned long long hash = HashMix(game->asteroidsHash, game->simTick);
+
+    hash = HashMix(hash, game->rngState);
+    hash = HashEntity(hash, &game->sPlayer);
+    hash = HashEntity(hash, &game->sSuperBeam);
+    for (int i = 0; i < MAX_SHOTS; i++) hash = HashEntity(hash, &game->sShots[i]);
+    for (int i = 0; i < MAX_LIVES; i++) hash = HashEntity(hash, &game->sLives[i]);
+
+    SimValue values[3] = { game->beamCharge, game->beamDelay, game->spawnInvincibility };
+    unsigned int bits[3] = { 0 };
+    memcpy(bits, values, sizeof(bits));
+
+    for (int i = 0; i < 3; i++) hash = HashMix(hash, bits[i]);
+    hash = HashMix(hash, (unsigned int)game->asteroidScore);
+    hash = HashMix(hash, (unsigned int)game->currentAsteroids);
+    hash = HashMix(hash, (unsigned int)game->lives);
+
+    return HashMix(hash, (game->isGameOver? 1 : 0) | (game->preDetonation? 2 : 0));
+}
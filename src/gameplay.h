@@ -0,0 +1,222 @@
+/*******************************************************************************************
+*
+*   gameplay - Asteroids game rules, simulation and world rendering
+*
+*   All game state lives in a GameState owned by the host (raylib_game.c), gameplay code
+*   keeps no state of its own between calls. That way the gameplay code can be built as a
+*   shared library and swapped while the game runs (see gameplay_module.h), the state
+*   survives the swap as long as the GameState layout does not change.
+*
+*   Host entry points are reached through the GameplayApi table returned by GetGameplayApi(),
+*   the only symbol looked up when loaded as a shared library.
+*
+********************************************************************************************/
+
+#ifndef GAMEPLAY_H
+#define GAMEPLAY_H
+
+#include "raylib.h"
+#include "rlgl.h"                           // Required for: rlRenderBatch
+
+#include "atlas_data.h"                     // Generated by atlas_packer: atlas size and sprite rectangles
+#include "fixed.h"                          // Required for: SimValue, SimVector2, float or fixed point simulation
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define GAMEPLAY_API_VERSION        2       // Increase when GameplayApi changes
+
+#define SCREEN_WIDTH                800     // Virtual screen size, HUD layout
+#define SCREEN_HEIGHT               450
+#define GAME_TICK_RATE              60      // Target ticks per second, fixed tick time with SUPPORT_FIXED_POINT
+
+// Player input bits for one tick, see GameReadInput()
+#define GAME_INPUT_LEFT             0x01    // KEY_A down
+#define GAME_INPUT_RIGHT            0x02    // KEY_D down
+#define GAME_INPUT_THRUST           0x04    // KEY_W down
+#define GAME_INPUT_SHOOT            0x08    // KEY_SPACE pressed
+#define GAME_INPUT_BEAM             0x10    // KEY_B pressed
+#define GAME_INPUT_RESTART          0x20    // KEY_R pressed
+#define GAME_INPUT_DEBUG            0x40    // KEY_F1 pressed
+#define GAME_INPUT_HELD             (GAME_INPUT_LEFT | GAME_INPUT_RIGHT | GAME_INPUT_THRUST)   // Key down bits, the rest are single presses
+
+#if !defined(MAX_ASTEROIDS)
+    #define MAX_ASTEROIDS 40                // Entity cap, can be raised from build flags for stress testing
+#endif
+#define MAX_SHOTS 10
+#define MAX_SOUNDS 2
+#if !defined(SPAWN_ASTEROIDS)
+    #define SPAWN_ASTEROIDS 10
+#endif
+#define MAX_LIVES 3
+#define SHOT_LIFETIME 1.6f                  // Seconds, about half a screen at shot speed
+
+// World size, independent of the viewport, the world wraps around on both axis
+// NOTE: World must be at least as big as the viewport
+#if !defined(WORLD_WIDTH)
+    #define WORLD_WIDTH 1600
+#endif
+#if !defined(WORLD_HEIGHT)
+    #define WORLD_HEIGHT 900
+#endif
+
+// Asteroids are stored in spatial chunks, chunks simulation rate depends on distance to camera
+// NOTE: Collision queries gather the chunks overlapped by a range around a point, wrapped
+// around the world, world size does not need to be a multiple of chunk size
+#define CHUNK_SIZE 256
+#define CHUNKS_X ((WORLD_WIDTH + CHUNK_SIZE - 1)/CHUNK_SIZE)
+#define CHUNKS_Y ((WORLD_HEIGHT + CHUNK_SIZE - 1)/CHUNK_SIZE)
+#define MAX_CHUNKS (CHUNKS_X*CHUNKS_Y)
+#define CHUNK_FULL_RATE_RADIUS 2            // Chunks (distance from camera chunk) simulated every tick
+#define CHUNK_REDUCED_RATE_RADIUS 4         // Chunks simulated every CHUNK_REDUCED_RATE_INTERVAL ticks, further ones are frozen
+#define CHUNK_REDUCED_RATE_INTERVAL 4
+
+// World render batch sizing, every world sprite must fit so the batch is submitted once per frame
+// NOTE: DrawCircle() vertex count grows with radius, bound taken at super beam radius
+#define WORLD_CIRCLE_MAX_VERTICES 144
+#define WORLD_BATCH_VERTICES ((MAX_ASTEROIDS + 1)*4 + (MAX_SHOTS + 1)*WORLD_CIRCLE_MAX_VERTICES)
+#define WORLD_BATCH_ELEMENTS (WORLD_BATCH_VERTICES/4 + 1)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    SimVector2 position;
+    SimVector2 speed;
+    SimValue rotation;
+    SimValue acceleration;
+    SimValue lifetime;
+    int type;
+    bool active;
+
+}sEntity;
+
+typedef enum {
+    TYPE_ASTEROID_SMALL = 0,
+    TYPE_ASTEROID_MED,
+    TYPE_ASTEROID_LARGE,
+    TYPE_PLAYER,
+    TYPE_SHOT
+}EntityType;
+
+// Sprite indices into atlasRects[], must match bake_atlas input order
+enum {
+    TEXTURE_METEOR_SMALL = ATLAS_SPRITE_SMALL_A,
+    TEXTURE_METEOR_MED = ATLAS_SPRITE_MED_B,
+    TEXTURE_METEOR_LARGE = ATLAS_SPRITE_BIG_A,
+    TEXTURE_PLAYER = ATLAS_SPRITE_PLAYER
+};
+
+enum {
+    SOUND_SHOOT =0,
+    SOUND_EXPLOSION
+};
+
+// Render batch stats for the last frame
+typedef struct {
+    int drawCalls;                      // Draw calls by state changes (mode, texture)
+    int vertices;                       // Vertices submitted
+    int flushes;                        // Implicit flushes caused by batch overflow
+    int submissions;                    // Total batch submissions to GL
+} BatchStats;
+
+// View culling stats for the last frame
+typedef struct {
+    int drawn;                          // Entities submitted for drawing
+    int culled;                         // Entities skipped, outside the visible rect
+} CullStats;
+
+// Chunked simulation stats for the last tick
+typedef struct {
+    int fullRate;                       // Chunks simulated this tick at full rate
+    int reducedRate;                    // Chunks simulated this tick at reduced rate
+    int asteroids;                      // Asteroids updated this tick
+} ChunkStats;
+
+// Complete game state, owned by the host
+typedef struct {
+    // Game
+    unsigned int rngState;                      // Random generator state, gameplay does not use raylib one so it can be saved
+    sEntity sPlayer;
+    sEntity sAsteroids[MAX_ASTEROIDS];
+    sEntity sShots[MAX_SHOTS];
+    sEntity sSuperBeam;
+    sEntity sLives[MAX_LIVES];
+    int asteroidScore;
+    int currentAsteroids;
+    bool isGameOver;
+    SimValue beamCharge;
+    SimValue beamDelay;
+    bool preDetonation;
+    int lives;
+    SimValue spawnInvincibility;
+    bool showDebug;
+
+    // Asteroid chunks, intrusive doubly linked lists over sAsteroids[] indices
+    unsigned int simTick;                       // Simulation ticks since startup
+    int liveAsteroids;                          // Active asteroids in all chunks
+    int chunkFirst[MAX_CHUNKS];                 // First asteroid in chunk, -1 if empty
+    unsigned int chunkLastTick[MAX_CHUNKS];     // Last tick the chunk was simulated
+    unsigned int chunkVisitTick[MAX_CHUNKS];    // Avoids visiting a chunk twice per tick on small worlds
+    int asteroidChunk[MAX_ASTEROIDS];
+    int asteroidNext[MAX_ASTEROIDS];
+    int asteroidPrev[MAX_ASTEROIDS];
+    ChunkStats chunkStats;
+
+    // State hash, asteroid contributions are updated as asteroids move, spawn or die
+    unsigned long long stateHash;               // Simulation state hash after the last tick, compare to find desyncs
+    unsigned long long asteroidsHash;           // Sum of asteroidHashes
+    unsigned long long asteroidHashes[MAX_ASTEROIDS];   // Per asteroid contribution, 0 if inactive
+    bool hashRebuild;                           // Recompute all contributions next tick, set when state is restored from outside
+
+    // Presentation, view fields are set by the host before every update
+    // NOTE: Presentation fields must stay last, rollback saves everything before camera
+    Camera2D camera;                            // World camera, follows the player
+    Vector2 viewSize;                           // Render target size in pixels
+    float viewScale;                            // Render target scale from screen size
+    bool silent;                                // Updates play no sounds, set while re-simulating ticks
+    Texture2D atlas;                            // All sprites packed in a single texture, see atlas_data.h
+    rlRenderBatch worldBatch;                   // Render batch for world sprites, default batch is kept for HUD
+    BatchStats worldBatchStats;
+    CullStats cullStats;
+    int visibleAsteroids[MAX_ASTEROIDS];        // Asteroid indices that passed view culling this frame
+    int visibleAsteroidsCount;
+    bool asteroidDrawn[MAX_ASTEROIDS];          // Drawn in some wrapped copy of the world this frame, counted once
+    bool shotDrawn[MAX_SHOTS];
+    int movedAsteroids[MAX_ASTEROIDS];          // Asteroids changing chunk this tick, scratch kept here so matches can tick on any thread
+} GameState;
+
+// Gameplay entry points, used by the host
+typedef struct {
+    unsigned int version;                       // GAMEPLAY_API_VERSION
+    unsigned int stateSize;                     // sizeof(GameState), must match the host one
+    void (*GameReset)(GameState *game);
+    unsigned int (*GameReadInput)(void);
+    void (*GameStep)(GameState *game, unsigned int input);
+    void (*GameStepPlayer)(GameState *game, unsigned int input, bool replay);
+    void (*GameRender)(GameState *game);
+} GameplayApi;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+const GameplayApi *GetGameplayApi(void);        // Get gameplay entry points
+
+void GameReset(GameState *game);                // Set game to default, new asteroids field
+unsigned int GameReadInput(void);               // Sample keyboard for this tick, GAME_INPUT_* bits
+void GameStep(GameState *game, unsigned int input);    // Update one tick from input: simulation and collisions
+void GameStepPlayer(GameState *game, unsigned int input, bool replay);   // Update player ship and shots only, for client prediction, no sounds when replaying
+void GameUpdate(GameState *game);               // Update one tick from keyboard input
+void GameRender(GameState *game);               // Draw world and HUD into the current render target
+void CheckAsteroidType(GameState *game, sEntity *entity);  // Split destroyed asteroid into smaller ones
+void PlayerDeath(GameState *game);              // Lose a life, respawn or end the game
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // GAMEPLAY_H
@@ -0,0 +1,210 @@
+/*******************************************************************************************
+*
+*   gameplay_module - Gameplay shared library loading and hot reload
+*
+*   NOTE: Library copies are deleted right after dlopen(), the mapping stays valid and no
+*   files are left behind, every copy gets a new name so the new library can be loaded
+*   before the current one is closed
+*
+********************************************************************************************/
+
+#include "gameplay_module.h"
+
+#if !defined(_WIN32) && !defined(PLATFORM_WEB)
+    #define GAMEPLAY_MODULE_DLOPEN
+#endif
+
+#if defined(GAMEPLAY_MODULE_DLOPEN)
+
+#include "mapped_file.h"                    // Required for: MapFile(), UnmapFile()
+
+#include <stdio.h>                          // Required for: snprintf(), fopen(), fwrite(), fclose(), remove()
+#include <string.h>                         // Required for: strlen(), memcpy()
+#include <dlfcn.h>                          // Required for: dlopen(), dlsym(), dlclose(), dlerror()
+#include <sys/stat.h>                       // Required for: stat()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define GAMEPLAY_MODULE_MAX_PATH    512
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Identifies a library build, linkers may rewrite the file in place or replace it
+typedef struct {
+    long long inode;
+    long long size;
+    long long time;                         // Modification time in nanoseconds
+} FileStamp;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static char libraryPath[GAMEPLAY_MODULE_MAX_PATH] = { 0 };
+static void *library = NULL;
+static const GameplayApi *api = NULL;
+static FileStamp loadedStamp = { 0 };       // Library file that was last loaded (or failed to)
+static FileStamp pendingStamp = { 0 };      // Changed library file, waiting to settle
+static double pendingTime = 0.0;
+static unsigned int copyCount = 0;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static bool GetFileStamp(const char *fileName, FileStamp *stamp);
+static bool IsSameStamp(FileStamp a, FileStamp b);
+static void *LoadLibraryCopy(const GameplayApi **libraryApi);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+const GameplayApi *GameplayModuleLoad(const char *fileName)
+{
+    GameplayModuleUnload();
+
+    if (strlen(fileName) >= GAMEPLAY_MODULE_MAX_PATH) return NULL;
+    memcpy(libraryPath, fileName, strlen(fileName) + 1);
+
+    GetFileStamp(libraryPath, &loadedStamp);
+    pendingStamp = loadedStamp;
+
+    library = LoadLibraryCopy(&api);
+    if (library != NULL) TraceLog(LOG_INFO, "GAMEPLAY: [%s] Gameplay library loaded", libraryPath);
+
+    return api;
+}
+
+const GameplayApi *GameplayModuleReload(void)
+{
+    FileStamp stamp = { 0 };
+
+    // Missing file means the library is being rebuilt right now
+    if ((library == NULL) || !GetFileStamp(libraryPath, &stamp) || IsSameStamp(stamp, loadedStamp)) return api;
+
+    // Wait until the linker is done writing the library
+    if (!IsSameStamp(stamp, pendingStamp))
+    {
+        pendingStamp = stamp;
+        pendingTime = GetTime();
+        return api;
+    }
+
+    if ((GetTime() - pendingTime) < GAMEPLAY_MODULE_SETTLE_TIME) return api;
+
+    loadedStamp = stamp;                    // A broken library is not retried until it changes again
+
+    const GameplayApi *libraryApi = NULL;
+    void *newLibrary = LoadLibraryCopy(&libraryApi);
+
+    if (newLibrary != NULL)
+    {
+        dlclose(library);
+        library = newLibrary;
+        api = libraryApi;
+        TraceLog(LOG_INFO, "GAMEPLAY: [%s] Gameplay library reloaded", libraryPath);
+    }
+
+    return api;
+}
+
+void GameplayModuleUnload(void)
+{
+    if (library != NULL) dlclose(library);
+
+    library = NULL;
+    api = NULL;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+static bool GetFileStamp(const char *fileName, FileStamp *stamp)
+{
+    struct stat info = { 0 };
+    if (stat(fileName, &info) != 0) return false;
+
+#if defined(__APPLE__)
+    long long nanoseconds = (long long)info.st_mtimespec.tv_nsec;
+#else
+    long long nanoseconds = (long long)info.st_mtim.tv_nsec;
+#endif
+
+    stamp->inode = (long long)info.st_ino;
+    stamp->size = (long long)info.st_size;
+    stamp->time = (long long)info.st_mtime*1000000000LL + nanoseconds;
+
+    return true;
+}
+
+static bool IsSameStamp(FileStamp a, FileStamp b)
+{
+    return (a.inode == b.inode) && (a.size == b.size) && (a.time == b.time);
+}
+
+// Load a private copy of the library and get its entry points, NULL if not valid
+static void *LoadLibraryCopy(const GameplayApi **libraryApi)
+{
+    char copyPath[GAMEPLAY_MODULE_MAX_PATH + 16] = { 0 };
+    snprintf(copyPath, sizeof(copyPath), "%s.%u", libraryPath, copyCount++);
+
+    MappedFile source = MapFile(libraryPath);
+    FILE *copy = (source.data != NULL)? fopen(copyPath, "wb") : NULL;
+
+    if (copy == NULL)
+    {
+        TraceLog(LOG_WARNING, "GAMEPLAY: [%s] Failed to copy gameplay library", libraryPath);
+        UnmapFile(&source);
+        return NULL;
+    }
+
+    bool copied = (fwrite(source.data, 1, source.size, copy) == source.size);
+    fclose(copy);
+    UnmapFile(&source);
+
+    void *handle = copied? dlopen(copyPath, RTLD_NOW | RTLD_LOCAL) : NULL;
+    if (handle == NULL) TraceLog(LOG_WARNING, "GAMEPLAY: [%s] Failed to load gameplay library: %s", libraryPath, copied? dlerror() : "write error");
+    remove(copyPath);
+
+    if (handle == NULL) return NULL;
+
+    // NOTE: ISO C does not allow casting dlsym() result to a function pointer, POSIX requires it to work
+    const GameplayApi *(*getApi)(void) = NULL;
+    *(void **)(&getApi) = dlsym(handle, "GetGameplayApi");
+
+    const GameplayApi *newApi = (getApi != NULL)? getApi() : NULL;
+
+    if ((newApi == NULL) || (newApi->version != GAMEPLAY_API_VERSION) || (newApi->stateSize != sizeof(GameState)))
+    {
+        TraceLog(LOG_WARNING, "GAMEPLAY: [%s] Gameplay library does not match the executable, GameState or API changed, restart required", libraryPath);
+        dlclose(handle);
+        return NULL;
+    }
+
+    *libraryApi = newApi;
+
+    return handle;
+}
+
+#else
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+const GameplayApi *GameplayModuleLoad(const char *fileName)
+{
+    TraceLog(LOG_WARNING, "GAMEPLAY: [%s] Gameplay library loading not supported on this platform", fileName);
+
+    return NULL;
+}
+
+const GameplayApi *GameplayModuleReload(void)
+{
+    return NULL;
+}
+
+void GameplayModuleUnload(void)
+{
+}
+
+#endif // GAMEPLAY_MODULE_DLOPEN
@@ -0,0 +1,49 @@
+/*******************************************************************************************
+*
+*   gameplay_module - Gameplay shared library loading and hot reload
+*
+*   Loads the gameplay code (see gameplay.h) from a shared library and reloads it when the
+*   library file changes, so gameplay and tuning changes only need the library rebuilt while
+*   the game keeps running. Game state is owned by the host and survives the swap.
+*
+*   The library is copied before loading, so the linker can overwrite it while it is in use,
+*   and only loaded once the file has not changed for GAMEPLAY_MODULE_SETTLE_TIME. If the new
+*   library fails to load, or its GameState layout differs from the host one, the current
+*   library is kept.
+*
+*   NOTE: Only available where dlopen() is (Linux, macOS), GameplayModuleLoad() returns NULL
+*   on other platforms
+*
+*   CONFIGURATION:
+*       #define SUPPORT_GAMEPLAY_RELOAD
+*           Development mode, gameplay is not linked into the executable and is loaded from
+*           the library path in GAMEPLAY_MODULE_PATH instead
+*
+********************************************************************************************/
+
+#ifndef GAMEPLAY_MODULE_H
+#define GAMEPLAY_MODULE_H
+
+#include "gameplay.h"                       // Required for: GameplayApi
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define GAMEPLAY_MODULE_SETTLE_TIME 0.25    // Seconds the library file must stay unchanged before reloading
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+const GameplayApi *GameplayModuleLoad(const char *fileName);    // Load gameplay library, NULL if it could not be loaded
+const GameplayApi *GameplayModuleReload(void);                  // Reload library if it changed, returns current entry points
+void GameplayModuleUnload(void);                                // Unload gameplay library
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // GAMEPLAY_MODULE_H
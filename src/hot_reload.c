@@ -0,0 +1,221 @@
+/*******************************************************************************************
+*
+*   hot_reload - Development assets hot reload
+*
+*   NOTE: Watcher thread is the only producer and main thread the only consumer of the
+*   reloaded assets queue, same scheme as the sfx mixer trigger queue
+*
+********************************************************************************************/
+
+#include "hot_reload.h"
+
+#if defined(__linux__)
+    #define HOT_RELOAD_INOTIFY
+#endif
+
+#if defined(HOT_RELOAD_INOTIFY)
+
+#include "thread.h"                         // Required for: ThreadStart(), ThreadJoin(), ATOMIC_LOAD(), ATOMIC_STORE()
+
+#include <string.h>                         // Required for: strcmp()
+#include <poll.h>                           // Required for: poll()
+#include <unistd.h>                         // Required for: read(), close()
+#include <sys/inotify.h>                    // Required for: inotify_init1(), inotify_add_watch()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define HOT_RELOAD_POLL_TIME        100     // Milliseconds between stop requests checks
+#define HOT_RELOAD_EVENTS_SIZE      4096    // Events read at once, enough for several file names
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static AssetRequest watched[HOT_RELOAD_MAX_ASSETS] = { 0 };
+static int watchedCount = 0;
+static int watchFd = -1;
+static Thread watchThread = { 0 };
+static unsigned int stopRequested = 0;      // Written by main thread only
+
+static LoadedAsset queue[HOT_RELOAD_QUEUE_SIZE] = { 0 };
+static unsigned int queueWrite = 0;         // Written by watcher thread only
+static unsigned int queueRead = 0;          // Written by main thread only
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void WatchMain(void *userData);
+static LoadedAsset DecodeFromDisk(const AssetRequest *request);
+static void UnloadAsset(LoadedAsset asset);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+bool HotReloadStart(const char *directory, const AssetRequest *requests, int count)
+{
+    HotReloadStop();
+
+    if (count > HOT_RELOAD_MAX_ASSETS) count = HOT_RELOAD_MAX_ASSETS;
+
+    watchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watchFd < 0) return false;
+
+    if (inotify_add_watch(watchFd, directory, IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+    {
+        TraceLog(LOG_WARNING, "HOT RELOAD: [%s] Failed to watch directory", directory);
+        close(watchFd);
+        watchFd = -1;
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) watched[i] = requests[i];
+    watchedCount = count;
+    stopRequested = 0;
+    queueWrite = 0;
+    queueRead = 0;
+
+    if (!ThreadStart(&watchThread, WatchMain, NULL))
+    {
+        close(watchFd);
+        watchFd = -1;
+        return false;
+    }
+
+    TraceLog(LOG_INFO, "HOT RELOAD: [%s] Watching %i assets", directory, count);
+
+    return true;
+}
+
+bool HotReloadPoll(LoadedAsset *asset)
+{
+    if (queueRead == ATOMIC_LOAD(&queueWrite)) return false;
+
+    *asset = queue[queueRead & (HOT_RELOAD_QUEUE_SIZE - 1)];
+    ATOMIC_STORE(&queueRead, queueRead + 1);
+
+    return true;
+}
+
+void HotReloadStop(void)
+{
+    if (watchFd < 0) return;
+
+    ATOMIC_STORE(&stopRequested, 1);
+    ThreadJoin(&watchThread);
+
+    LoadedAsset asset = { 0 };
+    while (HotReloadPoll(&asset)) UnloadAsset(asset);
+
+    close(watchFd);
+    watchFd = -1;
+    watchedCount = 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Watcher thread, waits for file events and decodes changed assets
+static void WatchMain(void *userData)
+{
+    (void)userData;
+
+    // NOTE: inotify events must be read into a buffer aligned for struct inotify_event
+    union {
+        struct inotify_event event;
+        char data[HOT_RELOAD_EVENTS_SIZE];
+    } events;
+
+    while (!ATOMIC_LOAD(&stopRequested))
+    {
+        struct pollfd watchPoll = { watchFd, POLLIN, 0 };
+        if (poll(&watchPoll, 1, HOT_RELOAD_POLL_TIME) <= 0) continue;
+
+        ssize_t length = read(watchFd, events.data, sizeof(events.data));
+        if (length <= 0) continue;
+
+        // Tools may write the same file more than once per save, every asset is decoded once per batch
+        bool changed[HOT_RELOAD_MAX_ASSETS] = { 0 };
+
+        for (ssize_t offset = 0; offset < length; )
+        {
+            const struct inotify_event *event = (const struct inotify_event *)(events.data + offset);
+
+            if (event->len > 0)
+            {
+                for (int i = 0; i < watchedCount; i++)
+                {
+                    if (strcmp(event->name, GetFileName(watched[i].fileName)) == 0) changed[i] = true;
+                }
+            }
+
+            offset += sizeof(struct inotify_event) + event->len;
+        }
+
+        for (int i = 0; i < watchedCount; i++)
+        {
+            if (!changed[i]) continue;
+
+            LoadedAsset asset = DecodeFromDisk(&watched[i]);
+
+            if ((asset.image.data == NULL) && (asset.wave.data == NULL))
+            {
+                TraceLog(LOG_WARNING, "HOT RELOAD: [%s] Failed to decode changed file", watched[i].fileName);
+            }
+            else if ((queueWrite - ATOMIC_LOAD(&queueRead)) < HOT_RELOAD_QUEUE_SIZE)
+            {
+                TraceLog(LOG_INFO, "HOT RELOAD: [%s] Reloaded", watched[i].fileName);
+                queue[queueWrite & (HOT_RELOAD_QUEUE_SIZE - 1)] = asset;
+                ATOMIC_STORE(&queueWrite, queueWrite + 1);
+            }
+            else UnloadAsset(asset);        // Main thread is not polling, next change reloads it again
+        }
+    }
+}
+
+// Decode asset from its source file, ignoring archives and caches used on startup
+static LoadedAsset DecodeFromDisk(const AssetRequest *request)
+{
+    LoadedAsset asset = { 0 };
+    asset.type = request->type;
+    asset.id = request->id;
+    asset.fileName = request->fileName;
+
+    if (request->type == ASSET_IMAGE) asset.image = LoadImage(request->fileName);
+    else asset.wave = LoadWave(request->fileName);
+
+    return asset;
+}
+
+static void UnloadAsset(LoadedAsset asset)
+{
+    if (asset.type == ASSET_IMAGE) UnloadImage(asset.image);
+    else UnloadWave(asset.wave);
+}
+
+#else
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+bool HotReloadStart(const char *directory, const AssetRequest *requests, int count)
+{
+    (void)requests;
+    (void)count;
+
+    TraceLog(LOG_WARNING, "HOT RELOAD: [%s] Not supported on this platform", directory);
+
+    return false;
+}
+
+bool HotReloadPoll(LoadedAsset *asset)
+{
+    (void)asset;
+
+    return false;
+}
+
+void HotReloadStop(void)
+{
+}
+
+#endif // HOT_RELOAD_INOTIFY
@@ -0,0 +1,48 @@
+/*******************************************************************************************
+*
+*   hot_reload - Development assets hot reload
+*
+*   Watches the resources directory and re-decodes watched assets when their file changes,
+*   on a watcher thread. Decoded assets are picked up on the main thread with HotReloadPoll(),
+*   at a frame boundary, where the old texture or sound can be replaced safely.
+*
+*   Changes are detected with inotify when a file is closed after writing or moved into the
+*   directory (editors that save through a temporary file), so half written files are never
+*   decoded. Reloaded assets are always decoded from disk, even if they were first loaded
+*   from the packed archive, embedded data or the PCM cache.
+*
+*   NOTE: Only available on Linux, HotReloadStart() returns false on other platforms
+*
+*   CONFIGURATION:
+*       #define SUPPORT_HOT_RELOAD
+*           Development mode, the game watches resources/ once loading is done
+*
+********************************************************************************************/
+
+#ifndef HOT_RELOAD_H
+#define HOT_RELOAD_H
+
+#include "loader.h"                         // Required for: AssetRequest, LoadedAsset
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define HOT_RELOAD_MAX_ASSETS       LOADER_MAX_ASSETS   // Maximum watched assets
+#define HOT_RELOAD_QUEUE_SIZE       8       // Reloaded assets waiting for the main thread, must be power of two
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool HotReloadStart(const char *directory, const AssetRequest *requests, int count);  // Start watching assets in directory
+bool HotReloadPoll(LoadedAsset *asset);                 // Get next reloaded asset, owned by the caller, false if none
+void HotReloadStop(void);                               // Stop watching, unload assets never polled
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // HOT_RELOAD_H
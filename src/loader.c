@@ -0,0 +1,149 @@
+/*******************************************************************************************
+*
+*   loader - Asynchronous asset loading
+*
+*   NOTE: Loader thread writes results in request order and publishes them by increasing
+*   the decoded counter, main thread only reads results below that counter
+*
+********************************************************************************************/
+
+#include "loader.h"
+#include "pcm_cache.h"                      // Required for: PcmCacheGetWave()
+#include "pak.h"                            // Required for: PakGetData()
+#include "embedded.h"                       // Required for: GetEmbeddedData()
+#include "startup_profiler.h"               // Required for: StartupZoneBegin(), StartupZoneEnd()
+#include "thread.h"                         // Required for: ThreadStart(), ThreadJoin(), ATOMIC_LOAD(), ATOMIC_STORE()
+
+#include <stddef.h>                         // Required for: NULL
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static AssetRequest requests[LOADER_MAX_ASSETS] = { 0 };
+static LoadedAsset results[LOADER_MAX_ASSETS] = { 0 };
+static unsigned int requestCount = 0;
+static unsigned int decoded = 0;            // Written by loader thread only (main thread if no thread)
+static unsigned int polled = 0;             // Main thread only
+static unsigned int cancelled = 0;          // Written by main thread only, stops loader thread early
+static Thread loaderThread = { 0 };
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void LoaderMain(void *userData);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+void LoaderStart(const AssetRequest *assets, int count)
+{
+    LoaderStop();
+
+    if (count > LOADER_MAX_ASSETS) count = LOADER_MAX_ASSETS;
+
+    for (int i = 0; i < count; i++) requests[i] = assets[i];
+    requestCount = (unsigned int)count;
+    decoded = 0;
+    polled = 0;
+    cancelled = 0;
+
+    if (!ThreadStart(&loaderThread, LoaderMain, NULL)) TraceLog(LOG_INFO, "LOADER: Threads not available, loading on main thread");
+}
+
+bool LoaderPoll(LoadedAsset *asset)
+{
+    if (polled >= requestCount) return false;
+
+    // Without loader thread, decode one asset per call to keep the main loop responsive
+    if (loaderThread.handle == NULL)
+    {
+        results[decoded] = LoaderDecodeAsset(&requests[decoded]);
+        decoded++;
+    }
+
+    if (polled >= ATOMIC_LOAD(&decoded)) return false;
+
+    *asset = results[polled];
+    polled++;
+
+    return true;
+}
+
+float LoaderGetProgress(void)
+{
+    return (requestCount > 0)? (float)polled/requestCount : 1.0f;
+}
+
+bool LoaderIsDone(void)
+{
+    return (polled >= requestCount);
+}
+
+void LoaderStop(void)
+{
+    ATOMIC_STORE(&cancelled, 1);
+    ThreadJoin(&loaderThread);
+
+    // Assets decoded but never handed to the caller are released here
+    for (unsigned int i = polled; i < decoded; i++)
+    {
+        if (results[i].type == ASSET_IMAGE) UnloadImage(results[i].image);
+        else if (!results[i].shared) UnloadWave(results[i].wave);
+    }
+
+    requestCount = 0;
+    decoded = 0;
+    polled = 0;
+}
+
+// Decode asset file, safe to call from any thread
+LoadedAsset LoaderDecodeAsset(const AssetRequest *request)
+{
+    LoadedAsset asset = { .type = request->type, .id = request->id, .fileName = request->fileName };
+    int zone = StartupZoneBegin(request->fileName);
+
+    const char *fileName = GetFileName(request->fileName);
+    const char *fileType = GetFileExtension(request->fileName);
+
+    // Files embedded in the executable or in the packed archive are decoded straight from memory,
+    // loose files otherwise
+    int packedSize = 0;
+    const unsigned char *packed = GetEmbeddedData(fileName, &packedSize);
+    if (packed == NULL) packed = PakGetData(fileName, &packedSize);
+
+    if (request->type == ASSET_IMAGE)
+    {
+        if (packed != NULL) asset.image = LoadImageFromMemory(fileType, packed, packedSize);
+        else asset.image = LoadImage(request->fileName);
+    }
+    else
+    {
+        // Pre-decoded waves are referenced from the cache, source files are decoded otherwise
+        asset.wave = PcmCacheGetWave(fileName);
+        asset.shared = (asset.wave.data != NULL);
+
+        if (!asset.shared)
+        {
+            if (packed != NULL) asset.wave = LoadWaveFromMemory(fileType, packed, packedSize);
+            else asset.wave = LoadWave(request->fileName);
+        }
+    }
+
+    StartupZoneEnd(zone);
+
+    return asset;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+static void LoaderMain(void *userData)
+{
+    (void)userData;
+
+    for (unsigned int i = 0; (i < requestCount) && !ATOMIC_LOAD(&cancelled); i++)
+    {
+        results[i] = LoaderDecodeAsset(&requests[i]);
+        ATOMIC_STORE(&decoded, i + 1);
+    }
+}
@@ -0,0 +1,68 @@
+/*******************************************************************************************
+*
+*   loader - Asynchronous asset loading
+*
+*   Images and waves are decoded on a loader thread, in request order. Decoded assets are
+*   picked up on the main thread with LoaderPoll(), where GPU uploads and audio buffers must
+*   be created. Without thread support (Web) one asset is decoded per LoaderPoll() call
+*   instead, so the main loop keeps running and can show loading progress.
+*
+*   NOTE: Files are read from memory when embedded (see embedded.h) or from the packed archive
+*   when available (see pak.h), otherwise from disk. Waves are
+*   taken from the PCM cache when available (see pcm_cache.h), both must be opened before
+*   LoaderStart() and kept open while shared waves are in use
+*
+********************************************************************************************/
+
+#ifndef LOADER_H
+#define LOADER_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define LOADER_MAX_ASSETS           16      // Maximum assets per LoaderStart() call
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum {
+    ASSET_IMAGE = 0,
+    ASSET_WAVE
+} AssetType;
+
+typedef struct {
+    AssetType type;
+    int id;                                 // Caller defined id, returned with the asset
+    const char *fileName;                   // Must stay valid until loading is done
+} AssetRequest;
+
+typedef struct {
+    AssetType type;
+    int id;
+    const char *fileName;                   // Requested file name
+    Image image;                            // ASSET_IMAGE data, owned by the caller once polled
+    Wave wave;                              // ASSET_WAVE data, owned by the caller once polled unless shared
+    bool shared;                            // Wave data references the PCM cache, do not unload it
+} LoadedAsset;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void LoaderStart(const AssetRequest *requests, int count);     // Start decoding assets in background
+bool LoaderPoll(LoadedAsset *asset);                            // Get next decoded asset, false if none is ready yet
+float LoaderGetProgress(void);                                  // Get fraction of assets already polled
+bool LoaderIsDone(void);                                        // Check if every asset has been polled
+void LoaderStop(void);                                          // Wait for loader thread, unload assets never polled
+LoadedAsset LoaderDecodeAsset(const AssetRequest *request);     // Decode single asset on the calling thread
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // LOADER_H
@@ -0,0 +1,128 @@
+/*******************************************************************************************
+*
+*   mapped_file - Read-only memory mapped files
+*
+********************************************************************************************/
+
+#include "mapped_file.h"
+
+#include <stdio.h>                          // Required for: FILE, fopen(), fread(), fclose()
+#include <stdlib.h>                         // Required for: malloc(), free()
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>                    // Required for: CreateFileA(), CreateFileMappingA(), MapViewOfFile()
+#elif !defined(PLATFORM_WEB)
+    #define MAPPED_FILE_POSIX
+    #include <fcntl.h>                      // Required for: open()
+    #include <unistd.h>                     // Required for: close()
+    #include <sys/mman.h>                   // Required for: mmap(), munmap()
+    #include <sys/stat.h>                   // Required for: fstat()
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static MappedFile ReadWholeFile(const char *fileName);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+MappedFile MapFile(const char *fileName)
+{
+    MappedFile file = { 0 };
+
+#if defined(_WIN32)
+    HANDLE fileHandle = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (fileHandle == INVALID_HANDLE_VALUE) return file;
+
+    LARGE_INTEGER size = { 0 };
+    GetFileSizeEx(fileHandle, &size);
+
+    HANDLE mapping = (size.QuadPart > 0)? CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+    CloseHandle(fileHandle);                // Mapping keeps its own reference
+
+    if (mapping == NULL) return ReadWholeFile(fileName);
+
+    file.data = (const unsigned char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (file.data == NULL)
+    {
+        CloseHandle(mapping);
+        return ReadWholeFile(fileName);
+    }
+
+    file.size = (size_t)size.QuadPart;
+    file.handle = mapping;
+    file.mapped = true;
+#elif defined(MAPPED_FILE_POSIX)
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return file;
+
+    struct stat info = { 0 };
+    if ((fstat(fd, &info) != 0) || (info.st_size <= 0))
+    {
+        close(fd);
+        return ReadWholeFile(fileName);
+    }
+
+    void *data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);                              // Mapping keeps its own reference
+
+    if (data == MAP_FAILED) return ReadWholeFile(fileName);
+
+    file.data = (const unsigned char *)data;
+    file.size = (size_t)info.st_size;
+    file.mapped = true;
+#else
+    file = ReadWholeFile(fileName);
+#endif
+
+    return file;
+}
+
+void UnmapFile(MappedFile *file)
+{
+    if (file->data == NULL) return;
+
+    if (file->mapped)
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(file->data);
+        CloseHandle((HANDLE)file->handle);
+#elif defined(MAPPED_FILE_POSIX)
+        munmap((void *)file->data, file->size);
+#endif
+    }
+    else free((void *)file->data);
+
+    *file = (MappedFile){ 0 };
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Fallback for platforms or files that can not be mapped
+static MappedFile ReadWholeFile(const char *fileName)
+{
+    MappedFile file = { 0 };
+    FILE *stream = fopen(fileName, "rb");
+
+    if (stream == NULL) return file;
+
+    fseek(stream, 0, SEEK_END);
+    long size = ftell(stream);
+    fseek(stream, 0, SEEK_SET);
+
+    unsigned char *data = (size > 0)? (unsigned char *)malloc((size_t)size) : NULL;
+
+    if ((data != NULL) && (fread(data, 1, (size_t)size, stream) == (size_t)size))
+    {
+        file.data = data;
+        file.size = (size_t)size;
+    }
+    else free(data);
+
+    fclose(stream);
+
+    return file;
+}
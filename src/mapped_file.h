@@ -0,0 +1,43 @@
+/*******************************************************************************************
+*
+*   mapped_file - Read-only memory mapped files
+*
+*   Maps a whole file in memory with mmap() on POSIX systems and file mappings on Windows.
+*   Platforms without mapping support (Web) read the file into an allocated buffer instead,
+*   callers use the data the same way in both cases.
+*
+*   NOTE: This module does not include raylib.h on purpose, windows.h conflicts with it
+*
+********************************************************************************************/
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <stddef.h>                         // Required for: size_t
+#include <stdbool.h>                        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    const unsigned char *data;              // File contents, NULL if file could not be opened
+    size_t size;                            // File size in bytes
+    void *handle;                           // Platform mapping handle
+    bool mapped;                            // Data is mapped, otherwise it was read into memory
+} MappedFile;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+MappedFile MapFile(const char *fileName);   // Map file read-only, data is NULL on failure
+void UnmapFile(MappedFile *file);           // Unmap file, data pointers into it become invalid
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,320 @@
+/*******************************************************************************************
+*
+*   net_peer - Two peers playing the same game over loopback UDP, with rollback
+*
+*   NOTE: Debug overlay toggles are kept out of the inputs sent, the caller handles them
+*   locally like network clients do
+*
+*   NOTE: Game starts again from a reset when peers synchronize, anything simulated before
+*   is dropped on both sides
+*
+********************************************************************************************/
+
+#include "net_peer.h"
+#include "net_session.h"                    // Required for: NET_PROTOCOL_ID, NET_TIMEOUT
+#include "net_socket.h"                     // Required for: NetSocket, NetSocketSend(), NetSocketReceive(), NetGetTime()
+
+#include <stddef.h>                         // Required for: NULL, offsetof()
+#include <string.h>                         // Required for: memset()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define NET_HEADER_SIZE             3
+
+// Packet types, after net_session ones
+#define NET_PACKET_PEER_SYNC        5
+#define NET_PACKET_PEER_INPUT       6
+#define NET_PACKET_PEER_DISCONNECT  7
+
+#define NET_PEER_MAX_INPUTS         (ROLLBACK_INPUT_HISTORY/2)    // Inputs sent per packet, oldest unacknowledged first
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static unsigned char packet[NET_SOCKET_MAX_PACKET] = { 0 };    // Scratch for sent and received packets
+
+static const GameplayApi *api = NULL;
+static NetSocket peerSocket = { -1, 0 };
+static unsigned short remotePeerPort = 0;
+static unsigned int localSeed = 0;          // Seed sent, used if local port is the lower one
+static bool synchronized = false;
+static bool remoteLeft = false;
+static unsigned int remoteAck = 0;          // Local ticks the remote peer received in order
+static unsigned int pendingPresses = 0;     // Key presses made while stalled
+static unsigned int remoteHashTick = NET_PEER_NO_HASH;     // Newest remote hash not compared yet
+static unsigned long long remoteHash = 0;
+static double lastReceiveTime = 0.0;
+
+static NetPeerStats stats = { 0 };
+static int windowFrames = 0;                // Stats being accumulated for the next stats
+static int windowStalls = 0;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void ReceivePeerPackets(GameState *game, double time);
+static void ReceivePeerInputs(const unsigned char *data, int size);
+static void Synchronize(GameState *game, unsigned int seed);
+static void SendInputs(void);
+static void CheckDesync(void);
+static int WriteHeader(unsigned char *data, int type);
+static bool IsValidHeader(const unsigned char *data, int size);
+static void WriteU32(unsigned char *data, unsigned int value);
+static unsigned int ReadU32(const unsigned char *data);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+bool NetPeerStart(unsigned short localPort, unsigned short remotePort, const GameplayApi *gameplay)
+{
+    NetPeerStop();
+
+#if !defined(SUPPORT_FIXED_POINT)
+    TraceLog(LOG_WARNING, "NET: Peer play requires a fixed point build (SUPPORT_FIXED_POINT)");
+    return false;
+#endif
+
+    if ((localPort == 0) || (remotePort == 0) || (localPort == remotePort))
+    {
+        TraceLog(LOG_WARNING, "NET: Peer ports must be set and different");
+        return false;
+    }
+
+    if (!NetSocketOpen(&peerSocket, localPort))
+    {
+        TraceLog(LOG_WARNING, "NET: Failed to listen on 127.0.0.1:%i", localPort);
+        return false;
+    }
+
+    api = gameplay;
+    remotePeerPort = remotePort;
+    localSeed = (unsigned int)(NetGetTime()*1000000.0) ^ ((unsigned int)localPort << 16);
+    if (localSeed == 0) localSeed = 1;      // Random generator gets stuck on 0
+    synchronized = false;
+    remoteLeft = false;
+    lastReceiveTime = 0.0;
+    stats = (NetPeerStats){ 0 };
+    windowFrames = 0;
+    windowStalls = 0;
+
+    TraceLog(LOG_INFO, "NET: Waiting for peer 127.0.0.1:%i on 127.0.0.1:%i", remotePort, peerSocket.port);
+
+    return true;
+}
+
+void NetPeerStop(void)
+{
+    if (peerSocket.handle < 0) return;
+
+    NetSocketSend(&peerSocket, remotePeerPort, packet, WriteHeader(packet, NET_PACKET_PEER_DISCONNECT));
+    NetSocketClose(&peerSocket);
+}
+
+bool NetPeerUpdate(GameState *game, unsigned int input)
+{
+    if (peerSocket.handle < 0) return false;
+
+    double time = NetGetTime();
+
+    ReceivePeerPackets(game, time);
+
+    if (remoteLeft || (synchronized && ((time - lastReceiveTime) > NET_TIMEOUT)))
+    {
+        TraceLog(LOG_INFO, "NET: Peer 127.0.0.1:%i %s", remotePeerPort, remoteLeft? "left" : "timed out");
+        NetSocketClose(&peerSocket);
+        return false;
+    }
+
+    if (!synchronized)
+    {
+        int size = WriteHeader(packet, NET_PACKET_PEER_SYNC);
+        WriteU32(packet + size, localSeed);
+        NetSocketSend(&peerSocket, remotePeerPort, packet, size + 4);
+
+        return true;
+    }
+
+    // Too far ahead of the remote peer, wait but keep key presses for the next tick
+    input = (input & ~GAME_INPUT_DEBUG) | pendingPresses;
+
+    if (RollbackAddLocalInput(input)) pendingPresses = 0;
+    else
+    {
+        pendingPresses = input & ~GAME_INPUT_HELD;
+        windowStalls++;
+    }
+
+    RollbackAdvance(game);
+    CheckDesync();
+    SendInputs();
+
+    stats.connected = ((time - lastReceiveTime) < NET_TIMEOUT);
+    stats.rollback = RollbackGetStats();
+
+    windowFrames++;
+    if (windowFrames >= GAME_TICK_RATE)
+    {
+        stats.stalls = windowStalls;
+        windowFrames = 0;
+        windowStalls = 0;
+    }
+
+    return true;
+}
+
+NetPeerStats NetPeerGetStats(void)
+{
+    return stats;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Handle sync, inputs and disconnect from the remote peer, other senders are ignored
+static void ReceivePeerPackets(GameState *game, double time)
+{
+    unsigned short port = 0;
+    int size = 0;
+
+    while ((size = NetSocketReceive(&peerSocket, packet, sizeof(packet), &port)) > 0)
+    {
+        if ((port != remotePeerPort) || !IsValidHeader(packet, size)) continue;
+
+        lastReceiveTime = time;
+
+        if (packet[2] == NET_PACKET_PEER_DISCONNECT) remoteLeft = true;
+        else if ((packet[2] == NET_PACKET_PEER_SYNC) && (size >= (NET_HEADER_SIZE + 4)))
+        {
+            if (!synchronized) Synchronize(game, (peerSocket.port < remotePeerPort)? localSeed : ReadU32(packet + NET_HEADER_SIZE));
+
+            // Remote peer may not have our seed yet, it keeps sending sync until it does
+            int reply = WriteHeader(packet, NET_PACKET_PEER_SYNC);
+            WriteU32(packet + reply, localSeed);
+            NetSocketSend(&peerSocket, remotePeerPort, packet, reply + 4);
+        }
+        else if ((packet[2] == NET_PACKET_PEER_INPUT) && synchronized) ReceivePeerInputs(packet + NET_HEADER_SIZE, size - NET_HEADER_SIZE);
+    }
+}
+
+// Read inputs packet payload: ack, inputs and remote hash
+static void ReceivePeerInputs(const unsigned char *data, int size)
+{
+    if (size < 9) return;
+
+    unsigned int ack = ReadU32(data);
+    unsigned int first = ReadU32(data + 4);
+    int count = data[8];
+
+    if (size < (9 + count + 12)) return;
+
+    // Packets can arrive out of order, newest acknowledgment wins
+    if ((ack > remoteAck) && (ack <= RollbackGetFrame())) remoteAck = ack;
+
+    for (int i = 0; i < count; i++) RollbackAddRemoteInput(first + i, data[9 + i]);
+
+    unsigned int hashTick = ReadU32(data + 9 + count);
+
+    if ((hashTick != NET_PEER_NO_HASH) && ((remoteHashTick == NET_PEER_NO_HASH) || (hashTick > remoteHashTick)))
+    {
+        remoteHashTick = hashTick;
+        remoteHash = (unsigned long long)ReadU32(data + 13 + count) | ((unsigned long long)ReadU32(data + 17 + count) << 32);
+    }
+}
+
+// Start the game from the agreed seed, simulation fields are reset so both peers start equal
+static void Synchronize(GameState *game, unsigned int seed)
+{
+    SimValue spawnInvincibility = game->spawnInvincibility;
+    bool showDebug = game->showDebug;
+
+    memset(game, 0, offsetof(GameState, camera));
+    game->spawnInvincibility = spawnInvincibility;
+    game->showDebug = showDebug;
+    game->rngState = seed;
+    api->GameReset(game);
+
+    RollbackInit(api);
+
+    synchronized = true;
+    remoteAck = 0;
+    pendingPresses = 0;
+    remoteHashTick = NET_PEER_NO_HASH;
+    stats.synchronized = true;
+
+    TraceLog(LOG_INFO, "NET: Synchronized with peer 127.0.0.1:%i, seed %u", remotePeerPort, seed);
+}
+
+// Send local inputs not acknowledged yet and the newest confirmed tick hash
+static void SendInputs(void)
+{
+    unsigned int frame = RollbackGetFrame();
+    unsigned int count = frame - remoteAck;
+    if (count > NET_PEER_MAX_INPUTS) count = NET_PEER_MAX_INPUTS;
+
+    int size = WriteHeader(packet, NET_PACKET_PEER_INPUT);
+
+    WriteU32(packet + size, (unsigned int)RollbackGetRemoteCount());
+    WriteU32(packet + size + 4, remoteAck);
+    packet[size + 8] = (unsigned char)count;
+    size += 9;
+
+    for (unsigned int i = 0; i < count; i++) packet[size++] = (unsigned char)RollbackGetLocalInput(remoteAck + i);
+
+    unsigned int hashTick = (unsigned int)RollbackGetRemoteCount() - 1;
+    unsigned long long hash = 0;
+
+    if ((RollbackGetRemoteCount() == 0) || !RollbackGetHash(hashTick, &hash)) hashTick = NET_PEER_NO_HASH;
+
+    WriteU32(packet + size, hashTick);
+    WriteU32(packet + size + 4, (unsigned int)hash);
+    WriteU32(packet + size + 8, (unsigned int)(hash >> 32));
+    size += 12;
+
+    NetSocketSend(&peerSocket, remotePeerPort, packet, size);
+}
+
+// Compare the newest remote hash once the same tick is confirmed locally
+static void CheckDesync(void)
+{
+    if (remoteHashTick == NET_PEER_NO_HASH) return;
+
+    unsigned long long hash = 0;
+
+    if (RollbackGetHash(remoteHashTick, &hash))
+    {
+        if (hash != remoteHash)
+        {
+            // Once desynchronized every tick differs, only the first one is logged
+            if (stats.desyncs == 0) TraceLog(LOG_WARNING, "NET: Desync with peer at tick %u", remoteHashTick);
+            stats.desyncs++;
+        }
+
+        remoteHashTick = NET_PEER_NO_HASH;
+    }
+    else if ((RollbackGetFrame() - remoteHashTick) > ROLLBACK_INPUT_HISTORY) remoteHashTick = NET_PEER_NO_HASH;   // Too old to compare
+}
+
+static int WriteHeader(unsigned char *data, int type)
+{
+    data[0] = NET_PROTOCOL_ID;
+    data[1] = NET_PEER_PROTOCOL_VERSION;
+    data[2] = (unsigned char)type;
+
+    return NET_HEADER_SIZE;
+}
+
+static bool IsValidHeader(const unsigned char *data, int size)
+{
+    return (size >= NET_HEADER_SIZE) && (data[0] == NET_PROTOCOL_ID) && (data[1] == NET_PEER_PROTOCOL_VERSION);
+}
+
+static void WriteU32(unsigned char *data, unsigned int value)
+{
+    for (int i = 0; i < 4; i++) data[i] = (unsigned char)(value >> (8*i));
+}
+
+static unsigned int ReadU32(const unsigned char *data)
+{
+    return (unsigned int)data[0] | ((unsigned int)data[1] << 8) | ((unsigned int)data[2] << 16) | ((unsigned int)data[3] << 24);
+}
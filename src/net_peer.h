@@ -0,0 +1,69 @@
+/*******************************************************************************************
+*
+*   net_peer - Two peers playing the same game over loopback UDP, with rollback
+*
+*   No host: both peers run the full simulation (see rollback.h) and only exchange inputs.
+*   Until both are synchronized each peer sends a sync packet with a seed every frame, the
+*   seed of the peer on the lower port starts the game on both sides. From there each peer
+*   sends every frame the local inputs the remote peer did not acknowledge yet, so a lost
+*   packet costs nothing, along with the state hash of its newest confirmed tick. Hashes are
+*   compared once the same tick is confirmed locally, a mismatch is counted as a desync.
+*
+*   Local input never waits on the network, the remote one is predicted. Local simulation
+*   stalls when it gets ROLLBACK_MAX_FRAMES ticks ahead of the remote inputs received,
+*   key presses made while stalled are kept for the next tick.
+*
+*   Start the game with --peer <localPort> <remotePort> on both sides, only fixed point
+*   builds (SUPPORT_FIXED_POINT) can play, float simulation is not the same on both peers.
+*
+*   PACKET FORMAT:
+*       u8 NET_PROTOCOL_ID, u8 NET_PEER_PROTOCOL_VERSION, u8 packet type
+*       NET_PACKET_PEER_SYNC:       u32 seed
+*       NET_PACKET_PEER_INPUT:      u32 ack (local ticks received in order), u32 first tick,
+*                                   u8 count, u8 inputs[count], u32 hash tick, u64 hash,
+*                                   hash tick is NET_PEER_NO_HASH while none is confirmed
+*       NET_PACKET_PEER_DISCONNECT: No payload, peer is leaving
+*
+********************************************************************************************/
+
+#ifndef NET_PEER_H
+#define NET_PEER_H
+
+#include "gameplay.h"                       // Required for: GameState, GameplayApi
+#include "rollback.h"                       // Required for: RollbackStats
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define NET_PEER_PROTOCOL_VERSION   1
+#define NET_PEER_NO_HASH            0xffffffff  // No confirmed tick to compare yet
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Peer stats, stalls are counted over the last second
+typedef struct {
+    bool synchronized;                      // Both peers started the game
+    bool connected;                         // Remote peer sent something recently
+    int stalls;                             // Frames local simulation waited on remote inputs
+    int desyncs;                            // Confirmed ticks with different hashes, since start
+    RollbackStats rollback;
+} NetPeerStats;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool NetPeerStart(unsigned short localPort, unsigned short remotePort, const GameplayApi *gameplay);  // Bind to 127.0.0.1:localPort, play with 127.0.0.1:remotePort
+void NetPeerStop(void);
+bool NetPeerUpdate(GameState *game, unsigned int input);    // Exchange inputs and simulate, false once the remote peer left
+NetPeerStats NetPeerGetStats(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // NET_PEER_H
@@ -0,0 +1,609 @@
+/*******************************************************************************************
+*
+*   net_session - Authoritative host and remote clients over loopback UDP
+*
+*   NOTE: Clients sharing the same acknowledged state get the same delta, it is encoded once
+*   per tick for consecutive clients with the same baseline
+*
+*   NOTE: Network ticks count host updates, not simulation ticks, they keep going while the
+*   game is over or being rewound
+*
+*   NOTE: The host applies one pilot input per tick, queued inputs beyond NET_INPUT_MAX_QUEUED
+*   are skipped keeping their key presses, late inputs repeat the keys held
+*
+********************************************************************************************/
+
+#include "net_session.h"
+#include "net_snapshot.h"                   // Required for: NetState, NetPilotState, NetStateWriteDelta(), NetPilotWrite()
+#include "net_socket.h"                     // Required for: NetSocket, NetSocketSend(), NetSocketReceive(), NetGetTime()
+
+#include <stddef.h>                         // Required for: NULL
+#include <string.h>                         // Required for: memcpy(), memset()
+#include <math.h>                           // Required for: floor(), fabs()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define NET_HEADER_SIZE             3
+
+// Packet types
+#define NET_PACKET_CLIENT_UPDATE    1
+#define NET_PACKET_STATE            2
+#define NET_PACKET_DISCONNECT       3
+#define NET_PACKET_PILOT_STATE      4
+
+#define NET_RENDER_CATCH_UP         0.05    // Fraction of the render delay error corrected per frame
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    bool active;
+    unsigned short port;
+    unsigned int ackTick;                   // Newest state the client received, NET_NO_BASELINE if none
+    double lastReceiveTime;
+} NetRemoteClient;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static unsigned char packet[NET_SOCKET_MAX_PACKET] = { 0 };    // Scratch for sent and received packets
+static unsigned char delta[NET_SOCKET_MAX_PACKET] = { 0 };     // Scratch for the state delta sent
+static unsigned char pilotData[NET_PILOT_MAX_SIZE] = { 0 };    // Scratch for the pilot state sent
+
+// Host
+static NetSocket hostSocket = { -1, 0 };
+static NetRemoteClient remoteClients[NET_MAX_CLIENTS] = { 0 };
+static NetState hostHistory[NET_HISTORY_SIZE] = { 0 };         // Sent states by tick%NET_HISTORY_SIZE
+static unsigned int hostTick = 0;
+static int pilotClient = -1;                // Client flying the ship, -1 for host keyboard
+static unsigned char pilotInputs[NET_INPUT_HISTORY] = { 0 };               // Received inputs by sequence%NET_INPUT_HISTORY
+static unsigned int pilotInputSequences[NET_INPUT_HISTORY] = { 0 };
+static unsigned int pilotNewest = 0;        // Newest input sequence received
+static unsigned int pilotApplied = 0;       // Last input sequence applied
+static unsigned int pilotHeld = 0;          // Keys held in the last input applied, repeated while inputs are late
+static NetPilotState pilotState = { 0 };
+static NetHostStats hostStats = { 0 };
+static int hostWindowTicks = 0;             // Stats being accumulated for the next hostStats
+static int hostWindowSends = 0;
+static int hostWindowBytes = 0;
+static double hostWindowEncodeTime = 0.0;
+static int hostWindowFullStates = 0;
+static int hostWindowOversized = 0;
+
+// Client
+static NetSocket clientSocket = { -1, 0 };
+static unsigned short serverPort = 0;
+static NetState clientHistory[NET_HISTORY_SIZE] = { 0 };       // Received states by tick%NET_HISTORY_SIZE
+static NetState decoded = { 0 };
+static NetPilotState receivedPilot = { 0 };
+static unsigned int newestTick = NET_NO_BASELINE;
+static bool isPilot = false;                // Newest state came with the pilot state, ship is predicted
+static NetPilotState clientPilot = { 0 };   // Pilot state of the newest state
+static unsigned char clientInputs[NET_INPUT_HISTORY] = { 0 };              // Sent inputs by sequence%NET_INPUT_HISTORY
+static unsigned int inputSequence = 0;      // Newest input sent, sequences start at 1
+static double renderTick = 0.0;             // Host tick being drawn, fractional
+static double clientLastReceiveTime = 0.0;
+static NetClientStats clientStats = { 0 };
+static unsigned int clientWindowTick = NET_NO_BASELINE;    // Stats being accumulated for the next clientStats
+static int clientWindowBytes = 0;
+static int clientWindowLost = 0;
+static int clientWindowUndecodable = 0;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void ReceiveClientPackets(double time);
+static void ReceivePilotInputs(const unsigned char *data, int size);
+static void RemoveRemoteClient(NetRemoteClient *client, const char *reason);
+static NetRemoteClient *GetRemoteClient(unsigned short port, bool create);
+static const NetState *GetHostBaseline(unsigned int ackTick);
+static void UpdateHostStats(void);
+static void ReceiveStates(double time);
+static void PredictPilot(GameState *game, const GameplayApi *gameplay);
+static const NetState *GetReceivedState(long long tick);
+static void UpdateClientStats(double time);
+static int WriteHeader(unsigned char *data, int type);
+static bool IsValidHeader(const unsigned char *data, int size);
+static void WriteTick(unsigned char *data, unsigned int tick);
+static unsigned int ReadTick(const unsigned char *data);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+bool NetHostStart(unsigned short port)
+{
+    NetHostStop();
+
+    if (!NetSocketOpen(&hostSocket, port))
+    {
+        TraceLog(LOG_WARNING, "NET: Failed to listen on 127.0.0.1:%i", port);
+        return false;
+    }
+
+    hostTick = 0;
+    pilotClient = -1;
+    hostStats = (NetHostStats){ 0 };
+    TraceLog(LOG_INFO, "NET: Hosting on 127.0.0.1:%i", hostSocket.port);
+
+    return true;
+}
+
+void NetHostStop(void)
+{
+    NetSocketClose(&hostSocket);
+
+    for (int i = 0; i < NET_MAX_CLIENTS; i++) remoteClients[i].active = false;
+    for (int i = 0; i < NET_HISTORY_SIZE; i++) hostHistory[i].tick = NET_NO_BASELINE;
+}
+
+unsigned int NetHostGetInput(unsigned int localInput)
+{
+    if (hostSocket.handle < 0) return localInput;
+
+    ReceiveClientPackets(NetGetTime());
+
+    if (pilotClient < 0) return localInput;
+
+    // Pilot too far ahead, skip inputs but keep their key presses
+    unsigned int presses = 0;
+
+    while ((pilotNewest - pilotApplied) > NET_INPUT_MAX_QUEUED)
+    {
+        pilotApplied++;
+        if (pilotInputSequences[pilotApplied%NET_INPUT_HISTORY] == pilotApplied) presses |= pilotInputs[pilotApplied%NET_INPUT_HISTORY] & ~GAME_INPUT_HELD;
+    }
+
+    unsigned int input = pilotHeld;         // Next input is late, keep holding keys
+
+    if (pilotNewest > pilotApplied)
+    {
+        // Input lost along with its resends, keys held are repeated for it
+        pilotApplied++;
+        if (pilotInputSequences[pilotApplied%NET_INPUT_HISTORY] == pilotApplied) input = pilotInputs[pilotApplied%NET_INPUT_HISTORY];
+
+        pilotHeld = input & GAME_INPUT_HELD;
+    }
+
+    // Debug overlay toggle stays with the local keyboard
+    return ((input | presses) & ~GAME_INPUT_DEBUG) | (localInput & GAME_INPUT_DEBUG);
+}
+
+void NetHostUpdate(const GameState *game)
+{
+    if (hostSocket.handle < 0) return;
+
+    ReceiveClientPackets(NetGetTime());
+
+    double start = NetGetTime();
+
+    hostTick++;
+    NetState *state = &hostHistory[hostTick%NET_HISTORY_SIZE];
+    NetStateCapture(game, hostTick, state);
+
+    int pilotSize = 0;
+    if (pilotClient >= 0)
+    {
+        NetPilotCapture(game, pilotApplied, &pilotState);
+        pilotSize = NetPilotWrite(&pilotState, pilotData, (int)sizeof(pilotData));
+    }
+
+    int deltaSize = -1;                     // Delta in scratch, -1 if none yet
+    unsigned int deltaBaseline = NET_NO_BASELINE;
+
+    for (int i = 0; i < NET_MAX_CLIENTS; i++)
+    {
+        if (!remoteClients[i].active) continue;
+
+        const NetState *baseline = GetHostBaseline(remoteClients[i].ackTick);
+        unsigned int baselineTick = (baseline != NULL)? baseline->tick : NET_NO_BASELINE;
+
+        if ((deltaSize < 0) || (baselineTick != deltaBaseline))
+        {
+            deltaSize = NetStateWriteDelta(baseline, state, delta, (int)sizeof(delta));
+            deltaBaseline = baselineTick;
+        }
+
+        // Pilot state goes before the delta
+        bool pilot = (i == pilotClient);
+        int size = NET_HEADER_SIZE + (pilot? pilotSize : 0) + deltaSize;
+
+        if ((deltaSize == 0) || (pilot && (pilotSize == 0)) || (size > (int)sizeof(packet)))
+        {
+            hostWindowOversized++;
+            continue;
+        }
+
+        WriteHeader(packet, pilot? NET_PACKET_PILOT_STATE : NET_PACKET_STATE);
+        if (pilot) memcpy(packet + NET_HEADER_SIZE, pilotData, pilotSize);
+        memcpy(packet + size - deltaSize, delta, deltaSize);
+        NetSocketSend(&hostSocket, remoteClients[i].port, packet, size);
+
+        if (baseline == NULL) hostWindowFullStates++;
+        hostWindowBytes += size;
+        hostWindowSends++;
+    }
+
+    hostWindowEncodeTime += NetGetTime() - start;
+    hostWindowTicks++;
+
+    if (hostWindowTicks >= GAME_TICK_RATE) UpdateHostStats();
+}
+
+NetHostStats NetHostGetStats(void)
+{
+    return hostStats;
+}
+
+bool NetClientStart(unsigned short hostPort)
+{
+    NetClientStop();
+
+    if (!NetSocketOpen(&clientSocket, 0))
+    {
+        TraceLog(LOG_WARNING, "NET: Failed to open client socket");
+        return false;
+    }
+
+    serverPort = hostPort;
+    newestTick = NET_NO_BASELINE;
+    isPilot = false;
+    inputSequence = 0;
+    renderTick = 0.0;
+    clientLastReceiveTime = 0.0;
+    clientStats = (NetClientStats){ 0 };
+    clientWindowBytes = 0;
+    clientWindowLost = 0;
+    clientWindowUndecodable = 0;
+    clientWindowTick = NET_NO_BASELINE;
+    for (int i = 0; i < NET_HISTORY_SIZE; i++) clientHistory[i].tick = NET_NO_BASELINE;
+
+    TraceLog(LOG_INFO, "NET: Connecting to 127.0.0.1:%i", hostPort);
+
+    return true;
+}
+
+void NetClientStop(void)
+{
+    if (clientSocket.handle < 0) return;
+
+    NetSocketSend(&clientSocket, serverPort, packet, WriteHeader(packet, NET_PACKET_DISCONNECT));
+    NetSocketClose(&clientSocket);
+}
+
+bool NetClientUpdate(GameState *game, const GameplayApi *gameplay, unsigned int input, float frameTime)
+{
+    if (clientSocket.handle < 0) return false;
+
+    double time = NetGetTime();
+    bool started = (newestTick != NET_NO_BASELINE);
+
+    ReceiveStates(time);
+
+    // Acknowledge newest state and send input, also connects and keeps the client alive
+    // NOTE: Last inputs are sent again with every update, a lost update costs nothing
+    inputSequence++;
+    clientInputs[inputSequence%NET_INPUT_HISTORY] = (unsigned char)input;
+
+    unsigned int inputCount = (inputSequence < NET_INPUT_RESENDS)? inputSequence : NET_INPUT_RESENDS;
+    int size = WriteHeader(packet, NET_PACKET_CLIENT_UPDATE);
+
+    WriteTick(packet + size, newestTick);
+    WriteTick(packet + size + 4, inputSequence);
+    packet[size + 8] = (unsigned char)inputCount;
+    size += 9;
+
+    for (unsigned int sequence = inputSequence - inputCount + 1; sequence <= inputSequence; sequence++) packet[size++] = clientInputs[sequence%NET_INPUT_HISTORY];
+
+    NetSocketSend(&clientSocket, serverPort, packet, size);
+
+    if (newestTick == NET_NO_BASELINE)
+    {
+        UpdateClientStats(time);
+        return false;
+    }
+
+    // Advance render time at tick rate, nudged toward the target delay behind newest state
+    double target = (double)newestTick - NET_INTERPOLATION_TICKS;
+
+    if (!started || (fabs(target - renderTick) > NET_INTERPOLATION_TICKS*4)) renderTick = target;
+    else
+    {
+        renderTick += frameTime*GAME_TICK_RATE;
+        renderTick += (target - renderTick)*NET_RENDER_CATCH_UP;
+    }
+
+    if (renderTick > (double)newestTick) renderTick = (double)newestTick;
+
+    UpdateClientStats(time);
+
+    // States around render time, lost ones are skipped
+    long long renderFloor = (long long)floor(renderTick);
+    const NetState *from = NULL;
+    const NetState *to = NULL;
+
+    for (long long tick = renderFloor; (from == NULL) && (tick > (long long)newestTick - NET_HISTORY_SIZE); tick--) from = GetReceivedState(tick);
+    for (long long tick = renderFloor + 1; (to == NULL) && (tick <= (long long)newestTick); tick++) to = GetReceivedState(tick);
+
+    if (from == NULL) from = to;
+    if (to == NULL) to = from;
+
+    float amount = (to->tick != from->tick)? (float)((renderTick - from->tick)/(double)(to->tick - from->tick)) : 1.0f;
+    if (amount < 0.0f) amount = 0.0f;
+    else if (amount > 1.0f) amount = 1.0f;
+
+    NetStateApply(game, from, to, amount);
+    PredictPilot(game, gameplay);
+
+    return true;
+}
+
+NetClientStats NetClientGetStats(void)
+{
+    return clientStats;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Handle client updates and disconnects, drop clients gone silent
+static void ReceiveClientPackets(double time)
+{
+    unsigned short port = 0;
+    int size = 0;
+
+    while ((size = NetSocketReceive(&hostSocket, packet, sizeof(packet), &port)) > 0)
+    {
+        if (!IsValidHeader(packet, size)) continue;
+
+        NetRemoteClient *client = GetRemoteClient(port, (packet[2] == NET_PACKET_CLIENT_UPDATE));
+        if (client == NULL) continue;
+
+        if (packet[2] == NET_PACKET_DISCONNECT) RemoveRemoteClient(client, "disconnected");
+        else if ((packet[2] == NET_PACKET_CLIENT_UPDATE) && (size >= (NET_HEADER_SIZE + 9)))
+        {
+            unsigned int ackTick = ReadTick(packet + NET_HEADER_SIZE);
+
+            // First client sending input flies the ship until it leaves
+            if (pilotClient < 0)
+            {
+                pilotClient = (int)(client - remoteClients);
+                pilotNewest = 0;
+                pilotApplied = 0;
+                pilotHeld = 0;
+                memset(pilotInputSequences, 0, sizeof(pilotInputSequences));
+                TraceLog(LOG_INFO, "NET: Client 127.0.0.1:%i flies the ship", port);
+            }
+
+            if (client == &remoteClients[pilotClient]) ReceivePilotInputs(packet + NET_HEADER_SIZE + 4, size - NET_HEADER_SIZE - 4);
+
+            // Updates can arrive out of order, newest acknowledged state wins
+            if ((ackTick != NET_NO_BASELINE) && (ackTick <= hostTick) &&
+                ((client->ackTick == NET_NO_BASELINE) || (ackTick > client->ackTick))) client->ackTick = ackTick;
+
+            client->lastReceiveTime = time;
+        }
+    }
+
+    for (int i = 0; i < NET_MAX_CLIENTS; i++)
+    {
+        if (remoteClients[i].active && ((time - remoteClients[i].lastReceiveTime) > NET_TIMEOUT)) RemoveRemoteClient(&remoteClients[i], "timed out");
+    }
+}
+
+// Queue pilot inputs: u32 newest sequence, u8 count, inputs oldest first
+static void ReceivePilotInputs(const unsigned char *data, int size)
+{
+    unsigned int newest = ReadTick(data);
+    unsigned int count = data[4];
+
+    if ((count == 0) || (count > newest) || ((int)count > (size - 5))) return;
+
+    // Inputs before the first update received are not waited for
+    if (pilotNewest == 0) pilotApplied = newest - count;
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        unsigned int sequence = newest - count + 1 + i;
+
+        if ((sequence <= pilotApplied) || ((sequence - pilotApplied) > NET_INPUT_HISTORY)) continue;
+
+        pilotInputs[sequence%NET_INPUT_HISTORY] = data[5 + i];
+        pilotInputSequences[sequence%NET_INPUT_HISTORY] = sequence;
+        if (sequence > pilotNewest) pilotNewest = sequence;
+    }
+}
+
+static void RemoveRemoteClient(NetRemoteClient *client, const char *reason)
+{
+    client->active = false;
+    TraceLog(LOG_INFO, "NET: Client 127.0.0.1:%i %s", client->port, reason);
+
+    if ((pilotClient >= 0) && (client == &remoteClients[pilotClient]))
+    {
+        pilotClient = -1;
+        TraceLog(LOG_INFO, "NET: Host keyboard flies the ship");
+    }
+}
+
+// Find client by port, a free slot is taken for new clients if create is set
+static NetRemoteClient *GetRemoteClient(unsigned short port, bool create)
+{
+    NetRemoteClient *freeClient = NULL;
+
+    for (int i = 0; i < NET_MAX_CLIENTS; i++)
+    {
+        if (remoteClients[i].active && (remoteClients[i].port == port)) return &remoteClients[i];
+        if (!remoteClients[i].active && (freeClient == NULL)) freeClient = &remoteClients[i];
+    }
+
+    if (!create || (freeClient == NULL)) return NULL;
+
+    *freeClient = (NetRemoteClient){ true, port, NET_NO_BASELINE, 0.0 };
+    TraceLog(LOG_INFO, "NET: Client 127.0.0.1:%i connected", port);
+
+    return freeClient;
+}
+
+// Get state the client acknowledged, NULL if none or no longer in history
+static const NetState *GetHostBaseline(unsigned int ackTick)
+{
+    if ((ackTick == NET_NO_BASELINE) || ((hostTick - ackTick) >= NET_HISTORY_SIZE)) return NULL;
+
+    const NetState *baseline = &hostHistory[ackTick%NET_HISTORY_SIZE];
+
+    return (baseline->tick == ackTick)? baseline : NULL;
+}
+
+static void UpdateHostStats(void)
+{
+    hostStats.clients = 0;
+    for (int i = 0; i < NET_MAX_CLIENTS; i++) if (remoteClients[i].active) hostStats.clients++;
+
+    hostStats.bytesPerTick = (hostWindowSends > 0)? (float)hostWindowBytes/hostWindowSends : 0.0f;
+    hostStats.encodeTime = (hostWindowSends > 0)? (float)(hostWindowEncodeTime/hostWindowSends) : 0.0f;
+    hostStats.fullStates = hostWindowFullStates;
+    hostStats.oversized = hostWindowOversized;
+    hostStats.pilotQueued = (pilotClient >= 0)? (int)(pilotNewest - pilotApplied) : 0;
+
+    hostWindowTicks = 0;
+    hostWindowSends = 0;
+    hostWindowBytes = 0;
+    hostWindowEncodeTime = 0.0;
+    hostWindowFullStates = 0;
+    hostWindowOversized = 0;
+}
+
+// Decode every state waiting, against the received state it was written for
+static void ReceiveStates(double time)
+{
+    unsigned short port = 0;
+    int size = 0;
+
+    while ((size = NetSocketReceive(&clientSocket, packet, sizeof(packet), &port)) > 0)
+    {
+        if ((port != serverPort) || !IsValidHeader(packet, size)) continue;
+        if ((packet[2] != NET_PACKET_STATE) && (packet[2] != NET_PACKET_PILOT_STATE)) continue;
+
+        bool pilot = (packet[2] == NET_PACKET_PILOT_STATE);
+        int pilotSize = pilot? NetPilotRead(packet + NET_HEADER_SIZE, size - NET_HEADER_SIZE, &receivedPilot) : 0;
+        if (pilot && (pilotSize == 0)) continue;
+
+        const unsigned char *stateDelta = packet + NET_HEADER_SIZE + pilotSize;
+        int deltaSize = size - NET_HEADER_SIZE - pilotSize;
+        unsigned int tick = NET_NO_BASELINE;
+        unsigned int baselineTick = NET_NO_BASELINE;
+
+        if (!NetStateReadTicks(stateDelta, deltaSize, &tick, &baselineTick)) continue;
+
+        clientLastReceiveTime = time;
+        clientWindowBytes += size;
+
+        // Late states older than history or already received
+        if ((newestTick != NET_NO_BASELINE) && ((long long)tick <= ((long long)newestTick - NET_HISTORY_SIZE/2))) continue;
+        if (GetReceivedState(tick) != NULL) continue;
+
+        const NetState *baseline = NULL;
+        if (baselineTick != NET_NO_BASELINE)
+        {
+            baseline = GetReceivedState(baselineTick);
+            if (baseline == NULL)
+            {
+                clientWindowUndecodable++;
+                continue;
+            }
+        }
+
+        if (!NetStateReadDelta(baseline, stateDelta, deltaSize, &decoded)) continue;
+        clientHistory[tick%NET_HISTORY_SIZE] = decoded;
+
+        if ((newestTick == NET_NO_BASELINE) || (tick > newestTick))
+        {
+            if (newestTick != NET_NO_BASELINE) clientWindowLost += (int)(tick - newestTick - 1);
+            newestTick = tick;
+
+            isPilot = pilot;
+            if (pilot) clientPilot = receivedPilot;
+        }
+    }
+}
+
+// Predict ship and shots: restart from the pilot state and replay inputs the host did not
+// apply yet, only the newest input plays sounds, older ones already did
+static void PredictPilot(GameState *game, const GameplayApi *gameplay)
+{
+    clientStats.pilot = isPilot;
+    clientStats.predictedTicks = 0;
+
+    if (!isPilot || (clientPilot.inputSequence > inputSequence)) return;
+
+    NetPilotApply(game, &clientPilot);
+
+    // Ship does not move once the game is over, until the host restarts it
+    if (clientPilot.isGameOver) return;
+
+    unsigned int first = clientPilot.inputSequence + 1;
+    if ((inputSequence - clientPilot.inputSequence) > NET_INPUT_HISTORY) first = inputSequence - NET_INPUT_HISTORY + 1;
+
+    for (unsigned int sequence = first; sequence <= inputSequence; sequence++)
+    {
+        gameplay->GameStepPlayer(game, clientInputs[sequence%NET_INPUT_HISTORY], (sequence != inputSequence));
+    }
+
+    clientStats.predictedTicks = (int)(inputSequence - first + 1);
+}
+
+// Get received state by tick, NULL if it never arrived or was overwritten
+static const NetState *GetReceivedState(long long tick)
+{
+    if (tick <= 0) return NULL;
+
+    const NetState *state = &clientHistory[tick%NET_HISTORY_SIZE];
+
+    return (state->tick == (unsigned int)tick)? state : NULL;
+}
+
+static void UpdateClientStats(double time)
+{
+    clientStats.connected = (clientLastReceiveTime > 0.0) && ((time - clientLastReceiveTime) < NET_TIMEOUT);
+    clientStats.delay = (newestTick != NET_NO_BASELINE)? (float)((double)newestTick - renderTick) : 0.0f;
+
+    if (newestTick == NET_NO_BASELINE) return;
+    if (clientWindowTick == NET_NO_BASELINE) clientWindowTick = newestTick;
+
+    int ticks = (int)(newestTick - clientWindowTick);
+    if (ticks < GAME_TICK_RATE) return;
+
+    clientStats.bytesPerTick = (ticks > 0)? (float)clientWindowBytes/ticks : 0.0f;
+    clientStats.lostStates = clientWindowLost;
+    clientStats.undecodable = clientWindowUndecodable;
+
+    clientWindowTick = newestTick;
+    clientWindowBytes = 0;
+    clientWindowLost = 0;
+    clientWindowUndecodable = 0;
+}
+
+static int WriteHeader(unsigned char *data, int type)
+{
+    data[0] = NET_PROTOCOL_ID;
+    data[1] = NET_PROTOCOL_VERSION;
+    data[2] = (unsigned char)type;
+
+    return NET_HEADER_SIZE;
+}
+
+static bool IsValidHeader(const unsigned char *data, int size)
+{
+    return (size >= NET_HEADER_SIZE) && (data[0] == NET_PROTOCOL_ID) && (data[1] == NET_PROTOCOL_VERSION);
+}
+
+static void WriteTick(unsigned char *data, unsigned int tick)
+{
+    for (int i = 0; i < 4; i++) data[i] = (unsigned char)(tick >> (8*i));
+}
+
+static unsigned int ReadTick(const unsigned char *data)
+{
+    return (unsigned int)data[0] | ((unsigned int)data[1] << 8) | ((unsigned int)data[2] << 16) | ((unsigned int)data[3] << 24);
+}
@@ -0,0 +1,105 @@
+/*******************************************************************************************
+*
+*   net_session - Authoritative host and remote clients over loopback UDP
+*
+*   The host runs the simulation as usual and sends every tick a delta compressed state
+*   (see net_snapshot.h) to each connected client. Clients send an update packet every
+*   frame: it connects them, keeps them alive and acknowledges the newest state received.
+*   Each client gets deltas against its own acknowledged state, so a lost packet only
+*   makes the next deltas a bit bigger. States are never resent.
+*
+*   Clients draw NET_INTERPOLATION_TICKS behind the newest state received, interpolating
+*   between the two states around their render time. Playback speed is nudged to keep
+*   that delay, so it holds under jitter and lost states.
+*
+*   The first client sending input flies the ship, the host keyboard does while there is
+*   none. That client does not wait for the host to see its input: ship and shots start
+*   from the exact pilot state sent with every state (see NetPilotState), then every input
+*   the host did not apply yet is replayed on top with GameStepPlayer(). Replaying only the
+*   ship and shots is cheap enough to redo every frame, so corrections from the host (a
+*   death, a shot hitting an asteroid) show up as soon as they arrive.
+*
+*   Everything runs on 127.0.0.1, start the game with --host [port] and every client with
+*   --connect [port].
+*
+*   PACKET FORMAT:
+*       u8 NET_PROTOCOL_ID, u8 NET_PROTOCOL_VERSION, u8 packet type
+*       NET_PACKET_CLIENT_UPDATE:   u32 ackTick, NET_NO_BASELINE while nothing was received,
+*                                   u32 inputSequence, u8 count, u8 inputs[count] oldest first
+*       NET_PACKET_STATE:           State delta (see net_snapshot.h)
+*       NET_PACKET_PILOT_STATE:     Pilot state then state delta (see net_snapshot.h)
+*       NET_PACKET_DISCONNECT:      No payload, client is leaving
+*
+*   NOTE: States do not get fragmented, a delta larger than a datagram is not sent (only
+*   possible with a raised MAX_ASTEROIDS), see NetHostStats.oversized
+*
+********************************************************************************************/
+
+#ifndef NET_SESSION_H
+#define NET_SESSION_H
+
+#include "gameplay.h"                       // Required for: GameState
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define NET_DEFAULT_PORT            27960
+#define NET_PROTOCOL_ID             0xa5
+#define NET_PROTOCOL_VERSION        2
+
+#define NET_MAX_CLIENTS             8
+#define NET_HISTORY_SIZE            64      // States kept as baselines, about a second
+#define NET_INTERPOLATION_TICKS     6       // Client render delay, rides over a few lost or late states
+#define NET_TIMEOUT                 3.0     // Seconds without packets before a peer is dropped
+
+#define NET_INPUT_HISTORY           64      // Client inputs kept for replay, host pilot input queue size
+#define NET_INPUT_RESENDS           8       // Last inputs sent with every client update
+#define NET_INPUT_MAX_QUEUED        4       // Pilot inputs waiting on the host before skipping ahead
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Host stats, averaged over the last second
+typedef struct {
+    int clients;
+    float bytesPerTick;                     // State bytes sent per client per tick
+    float encodeTime;                       // State capture and delta encoding per client per tick, seconds
+    int fullStates;                         // States sent without baseline
+    int oversized;                          // States too big for a datagram, not sent
+    int pilotQueued;                        // Pilot inputs received not applied yet
+} NetHostStats;
+
+// Client stats, averaged over the last second
+typedef struct {
+    bool connected;                         // Host sent something recently
+    float bytesPerTick;                     // State bytes received per tick
+    int lostStates;                         // States never received
+    int undecodable;                        // States whose baseline was already dropped
+    float delay;                            // Render time behind newest state, ticks
+    bool pilot;                             // Flying the ship
+    int predictedTicks;                     // Inputs replayed last frame, ahead of the host
+} NetClientStats;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool NetHostStart(unsigned short port);                     // Listen for clients on 127.0.0.1:port
+void NetHostStop(void);
+unsigned int NetHostGetInput(unsigned int localInput);      // Handle client packets, get pilot input for this tick (localInput without pilot)
+void NetHostUpdate(const GameState *game);                  // Handle client packets and send this tick state, call after every tick
+NetHostStats NetHostGetStats(void);
+
+bool NetClientStart(unsigned short hostPort);               // Connect to host on 127.0.0.1:hostPort
+void NetClientStop(void);
+bool NetClientUpdate(GameState *game, const GameplayApi *gameplay, unsigned int input, float frameTime);   // Send input, receive states and set game for drawing, false until the first state arrives
+NetClientStats NetClientGetStats(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // NET_SESSION_H
@@ -0,0 +1,543 @@
+/*******************************************************************************************
+*
+*   net_snapshot - Quantized game state for network replication, delta compressed
+*
+*   NOTE: Values are written byte by byte in little-endian order, host and clients do
+*   not need to share endianness or struct layout
+*
+*   NOTE: Applied states only feed drawing, simulation fields not sent (speeds, timers)
+*   are left as they are in the client game state
+*
+********************************************************************************************/
+
+#include "net_snapshot.h"
+
+#include <string.h>                         // Required for: memset(), memcpy()
+#include <math.h>                           // Required for: floorf(), fabsf()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+// Entity fields present in a delta record
+#define NET_FIELD_ACTIVE            0x01    // Entity is active, inactive entities have no other field
+#define NET_FIELD_MOVE              0x02    // Small move, signed byte offsets
+#define NET_FIELD_POSITION          0x04    // Full position
+#define NET_FIELD_ROTATION          0x08
+#define NET_FIELD_TYPE              0x10
+
+// Quantized positions must fit 16 bits, lower NET_POSITION_SCALE for bigger worlds
+typedef char NetPositionRangeCheck[(((WORLD_WIDTH + 2*NET_POSITION_MARGIN)*NET_POSITION_SCALE <= 65535) &&
+                                    ((WORLD_HEIGHT + 2*NET_POSITION_MARGIN)*NET_POSITION_SCALE <= 65535))? 1 : -1];
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    unsigned char *data;
+    int size;
+    int capacity;
+    bool overflow;                          // Something did not fit, size is no longer valid
+} NetWriter;
+
+typedef struct {
+    const unsigned char *data;
+    int size;
+    int position;
+    bool overflow;                          // Read past the end, values read are zero
+} NetReader;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static NetEntity CaptureEntity(const sEntity *entity, bool active);
+static unsigned short QuantizePosition(SimValue value);
+static unsigned short QuantizeAngle(SimValue degrees);
+static bool IsSameEntity(const NetEntity *a, const NetEntity *b);
+static void WriteEntity(NetWriter *writer, const NetEntity *base, const NetEntity *entity);
+static void ReadEntity(NetReader *reader, NetEntity *entity);
+static void WriteU8(NetWriter *writer, unsigned int value);
+static void WriteU16(NetWriter *writer, unsigned int value);
+static void WriteU32(NetWriter *writer, unsigned int value);
+static unsigned int ReadU8(NetReader *reader);
+static unsigned int ReadU16(NetReader *reader);
+static unsigned int ReadU32(NetReader *reader);
+static void WriteSim(NetWriter *writer, SimValue value);
+static SimValue ReadSim(NetReader *reader);
+static void WritePilotEntity(NetWriter *writer, const sEntity *entity, bool lifetime);
+static void ReadPilotEntity(NetReader *reader, sEntity *entity, bool lifetime);
+static void SetPilotEntity(sEntity *entity, const sEntity *pilot);
+static sEntity *GetEntity(GameState *game, int index);
+static float GetPosition(unsigned short value);
+static float LerpPosition(float from, float to, float amount, float size);
+static float LerpAngle(unsigned short from, unsigned short to, float amount);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+void NetStateCapture(const GameState *game, unsigned int tick, NetState *state)
+{
+    state->tick = tick;
+    state->asteroidScore = (unsigned int)game->asteroidScore;
+    state->lives = (unsigned char)game->lives;
+
+    float charge = SIM_TO_FLOAT(game->beamCharge)*NET_CHARGE_SCALE;
+    state->beamCharge = (unsigned short)((charge < 0.0f)? 0.0f : (charge > 65535.0f)? 65535.0f : charge);
+
+    state->flags = 0;
+    if (game->isGameOver) state->flags |= NET_STATE_GAME_OVER;
+    if (game->preDetonation) state->flags |= NET_STATE_PRE_DETONATION;
+    if (game->spawnInvincibility > 0) state->flags |= NET_STATE_INVINCIBLE;
+
+    // Player has no active flag, it is always drawn
+    state->entities[NET_ENTITY_PLAYER] = CaptureEntity(&game->sPlayer, true);
+    state->entities[NET_ENTITY_BEAM] = CaptureEntity(&game->sSuperBeam, game->sSuperBeam.active);
+    for (int i = 0; i < MAX_SHOTS; i++) state->entities[NET_ENTITY_SHOTS + i] = CaptureEntity(&game->sShots[i], game->sShots[i].active);
+    for (int i = 0; i < MAX_ASTEROIDS; i++) state->entities[NET_ENTITY_ASTEROIDS + i] = CaptureEntity(&game->sAsteroids[i], game->sAsteroids[i].active);
+}
+
+int NetStateWriteDelta(const NetState *baseline, const NetState *state, unsigned char *buffer, int bufferSize)
+{
+    static const NetEntity empty = { 0 };
+    NetWriter writer = { buffer, 0, bufferSize, false };
+
+    WriteU32(&writer, state->tick);
+    WriteU32(&writer, (baseline != NULL)? baseline->tick : NET_NO_BASELINE);
+    WriteU32(&writer, state->asteroidScore);
+    WriteU8(&writer, state->lives);
+    WriteU16(&writer, state->beamCharge);
+    WriteU8(&writer, state->flags);
+
+    // Changed bitmask is filled while entities are written
+    int maskOffset = writer.size;
+    int maskSize = (NET_ENTITY_COUNT + 7)/8;
+
+    if ((writer.size + maskSize) > writer.capacity) return 0;
+    memset(buffer + maskOffset, 0, maskSize);
+    writer.size += maskSize;
+
+    for (int i = 0; i < NET_ENTITY_COUNT; i++)
+    {
+        const NetEntity *base = (baseline != NULL)? &baseline->entities[i] : &empty;
+        if (IsSameEntity(base, &state->entities[i])) continue;
+
+        buffer[maskOffset + i/8] |= (unsigned char)(1 << (i%8));
+        WriteEntity(&writer, base, &state->entities[i]);
+    }
+
+    return writer.overflow? 0 : writer.size;
+}
+
+bool NetStateReadTicks(const unsigned char *data, int size, unsigned int *tick, unsigned int *baselineTick)
+{
+    NetReader reader = { data, size, 0, false };
+
+    *tick = ReadU32(&reader);
+    *baselineTick = ReadU32(&reader);
+
+    return !reader.overflow && (*tick != NET_NO_BASELINE);
+}
+
+bool NetStateReadDelta(const NetState *baseline, const unsigned char *data, int size, NetState *state)
+{
+    NetReader reader = { data, size, 0, false };
+
+    if (baseline != NULL) *state = *baseline;
+    else memset(state, 0, sizeof(NetState));
+
+    state->tick = ReadU32(&reader);
+    unsigned int baselineTick = ReadU32(&reader);
+    state->asteroidScore = ReadU32(&reader);
+    state->lives = (unsigned char)ReadU8(&reader);
+    state->beamCharge = (unsigned short)ReadU16(&reader);
+    state->flags = (unsigned char)ReadU8(&reader);
+
+    if (baselineTick != ((baseline != NULL)? baseline->tick : NET_NO_BASELINE)) return false;
+    if (state->lives > MAX_LIVES) return false;
+
+    int maskOffset = reader.position;
+    reader.position += (NET_ENTITY_COUNT + 7)/8;
+    if (reader.position > reader.size) return false;
+
+    for (int i = 0; i < NET_ENTITY_COUNT; i++)
+    {
+        if (!(data[maskOffset + i/8] & (1 << (i%8)))) continue;
+
+        ReadEntity(&reader, &state->entities[i]);
+        if (!NetEntityIsValid(i, &state->entities[i])) return false;   // Types index sprite rectangles
+    }
+
+    return !reader.overflow && (reader.position == reader.size);
+}
+
+bool NetEntityIsValid(int index, const NetEntity *entity)
+{
+    if (!entity->active) return true;
+    if (index == NET_ENTITY_PLAYER) return (entity->type == TYPE_PLAYER);
+    if (index < NET_ENTITY_ASTEROIDS) return (entity->type <= TYPE_SHOT);   // Shots and beam are drawn as circles
+
+    return (entity->type <= TYPE_ASTEROID_LARGE);
+}
+
+void NetStateApply(GameState *game, const NetState *from, const NetState *to, float amount)
+{
+    game->asteroidScore = (int)to->asteroidScore;
+    game->lives = to->lives;
+    game->beamCharge = SIM_FROM_FLOAT((float)to->beamCharge/NET_CHARGE_SCALE);
+    game->isGameOver = (to->flags & NET_STATE_GAME_OVER) != 0;
+    game->preDetonation = (to->flags & NET_STATE_PRE_DETONATION) != 0;
+    game->spawnInvincibility = (to->flags & NET_STATE_INVINCIBLE)? SIM(1.0f) : 0;
+    for (int i = 0; i < MAX_LIVES; i++) game->sLives[i].active = (i < to->lives);
+
+    for (int i = 0; i < NET_ENTITY_COUNT; i++)
+    {
+        const NetEntity *previous = &from->entities[i];
+        const NetEntity *entity = &to->entities[i];
+        sEntity *view = GetEntity(game, i);
+
+        view->active = (entity->active != 0);
+        if (!view->active) continue;
+
+        float x = GetPosition(entity->x);
+        float y = GetPosition(entity->y);
+        float rotation = (float)entity->rotation*360.0f/65536.0f;
+
+        // Entities just spawned or reused for something else are not interpolated
+        if (previous->active && (previous->type == entity->type))
+        {
+            x = LerpPosition(GetPosition(previous->x), x, amount, (float)WORLD_WIDTH);
+            y = LerpPosition(GetPosition(previous->y), y, amount, (float)WORLD_HEIGHT);
+            rotation = LerpAngle(previous->rotation, entity->rotation, amount);
+        }
+
+        view->position = (SimVector2){ SIM_FROM_FLOAT(x), SIM_FROM_FLOAT(y) };
+        view->rotation = SIM_FROM_FLOAT(rotation);
+        view->type = entity->type;
+    }
+
+    // Chunk lists drive view culling
+    for (int i = 0; i < MAX_CHUNKS; i++) game->chunkFirst[i] = -1;
+    game->liveAsteroids = 0;
+
+    for (int i = MAX_ASTEROIDS - 1; i >= 0; i--)
+    {
+        if (!game->sAsteroids[i].active) continue;
+
+        int cx = SIM_TO_INT(game->sAsteroids[i].position.x)/CHUNK_SIZE;
+        int cy = SIM_TO_INT(game->sAsteroids[i].position.y)/CHUNK_SIZE;
+        cx = (cx < 0)? 0 : (cx > (CHUNKS_X - 1))? CHUNKS_X - 1 : cx;
+        cy = (cy < 0)? 0 : (cy > (CHUNKS_Y - 1))? CHUNKS_Y - 1 : cy;
+        int chunk = cy*CHUNKS_X + cx;
+
+        game->asteroidChunk[i] = chunk;
+        game->asteroidPrev[i] = -1;
+        game->asteroidNext[i] = game->chunkFirst[chunk];
+        if (game->chunkFirst[chunk] != -1) game->asteroidPrev[game->chunkFirst[chunk]] = i;
+        game->chunkFirst[chunk] = i;
+        game->liveAsteroids++;
+    }
+
+    game->currentAsteroids = game->liveAsteroids;
+
+    // Camera follows the player, centered on the render target
+    game->camera.target = SIM_TO_VECTOR2(game->sPlayer.position);
+    game->camera.offset = (Vector2){ game->viewSize.x/2.0f, game->viewSize.y/2.0f };
+    game->camera.zoom = game->viewScale;
+}
+
+void NetPilotCapture(const GameState *game, unsigned int inputSequence, NetPilotState *pilot)
+{
+    pilot->inputSequence = inputSequence;
+    pilot->isGameOver = game->isGameOver;
+    pilot->player = game->sPlayer;
+    memcpy(pilot->shots, game->sShots, sizeof(pilot->shots));
+}
+
+int NetPilotWrite(const NetPilotState *pilot, unsigned char *buffer, int bufferSize)
+{
+    NetWriter writer = { buffer, 0, bufferSize, false };
+    unsigned int activeShots = 0;
+
+    for (int i = 0; i < MAX_SHOTS; i++) if (pilot->shots[i].active) activeShots |= (1u << i);
+
+    WriteU32(&writer, pilot->inputSequence);
+    WriteU8(&writer, pilot->isGameOver);
+    WritePilotEntity(&writer, &pilot->player, false);
+    WriteU16(&writer, activeShots);
+
+    for (int i = 0; i < MAX_SHOTS; i++) if (pilot->shots[i].active) WritePilotEntity(&writer, &pilot->shots[i], true);
+
+    return writer.overflow? 0 : writer.size;
+}
+
+int NetPilotRead(const unsigned char *data, int size, NetPilotState *pilot)
+{
+    NetReader reader = { data, size, 0, false };
+
+    memset(pilot, 0, sizeof(NetPilotState));
+    pilot->inputSequence = ReadU32(&reader);
+    pilot->isGameOver = (ReadU8(&reader) != 0);
+    ReadPilotEntity(&reader, &pilot->player, false);
+
+    unsigned int activeShots = ReadU16(&reader);
+    if (activeShots >= (1u << MAX_SHOTS)) return 0;
+
+    for (int i = 0; i < MAX_SHOTS; i++)
+    {
+        if (!(activeShots & (1u << i))) continue;
+
+        ReadPilotEntity(&reader, &pilot->shots[i], true);
+        pilot->shots[i].active = true;
+    }
+
+    return reader.overflow? 0 : reader.position;
+}
+
+// NOTE: Only sent fields are set, entity types are kept
+void NetPilotApply(GameState *game, const NetPilotState *pilot)
+{
+    SetPilotEntity(&game->sPlayer, &pilot->player);
+    for (int i = 0; i < MAX_SHOTS; i++) SetPilotEntity(&game->sShots[i], &pilot->shots[i]);
+
+    game->camera.target = SIM_TO_VECTOR2(game->sPlayer.position);
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+static NetEntity CaptureEntity(const sEntity *entity, bool active)
+{
+    NetEntity captured = { 0 };
+
+    if (active)
+    {
+        captured.x = QuantizePosition(entity->position.x);
+        captured.y = QuantizePosition(entity->position.y);
+        captured.rotation = QuantizeAngle(entity->rotation);
+        captured.type = (unsigned char)entity->type;
+        captured.active = 1;
+    }
+
+    return captured;
+}
+
+static unsigned short QuantizePosition(SimValue value)
+{
+    float scaled = (SIM_TO_FLOAT(value) + NET_POSITION_MARGIN)*NET_POSITION_SCALE + 0.5f;
+
+    if (scaled < 0.0f) scaled = 0.0f;
+    else if (scaled > 65535.0f) scaled = 65535.0f;
+
+    return (unsigned short)scaled;
+}
+
+static unsigned short QuantizeAngle(SimValue degrees)
+{
+    float turns = SIM_TO_FLOAT(degrees)/360.0f;
+    turns -= floorf(turns);
+
+    return (unsigned short)((int)(turns*65536.0f + 0.5f) & 0xffff);
+}
+
+static bool IsSameEntity(const NetEntity *a, const NetEntity *b)
+{
+    return (a->x == b->x) && (a->y == b->y) && (a->rotation == b->rotation) && (a->type == b->type) && (a->active == b->active);
+}
+
+// Write changed fields of an entity, base is the entity in the baseline
+static void WriteEntity(NetWriter *writer, const NetEntity *base, const NetEntity *entity)
+{
+    unsigned int fields = 0;
+    int dx = (int)entity->x - (int)base->x;
+    int dy = (int)entity->y - (int)base->y;
+
+    if (entity->active)
+    {
+        fields |= NET_FIELD_ACTIVE;
+        if ((dx != 0) || (dy != 0)) fields |= ((dx >= -128) && (dx <= 127) && (dy >= -128) && (dy <= 127))? NET_FIELD_MOVE : NET_FIELD_POSITION;
+        if (entity->rotation != base->rotation) fields |= NET_FIELD_ROTATION;
+        if (entity->type != base->type) fields |= NET_FIELD_TYPE;
+    }
+
+    WriteU8(writer, fields);
+
+    if (fields & NET_FIELD_MOVE)
+    {
+        WriteU8(writer, (unsigned int)(dx & 0xff));
+        WriteU8(writer, (unsigned int)(dy & 0xff));
+    }
+    if (fields & NET_FIELD_POSITION)
+    {
+        WriteU16(writer, entity->x);
+        WriteU16(writer, entity->y);
+    }
+    if (fields & NET_FIELD_ROTATION) WriteU16(writer, entity->rotation);
+    if (fields & NET_FIELD_TYPE) WriteU8(writer, entity->type);
+}
+
+// Read entity record over the baseline entity
+static void ReadEntity(NetReader *reader, NetEntity *entity)
+{
+    unsigned int fields = ReadU8(reader);
+
+    if (!(fields & NET_FIELD_ACTIVE))
+    {
+        *entity = (NetEntity){ 0 };
+        return;
+    }
+
+    if (fields & NET_FIELD_MOVE)
+    {
+        int dx = (int)ReadU8(reader);
+        int dy = (int)ReadU8(reader);
+
+        entity->x = (unsigned short)(entity->x + ((dx > 127)? dx - 256 : dx));
+        entity->y = (unsigned short)(entity->y + ((dy > 127)? dy - 256 : dy));
+    }
+    if (fields & NET_FIELD_POSITION)
+    {
+        entity->x = (unsigned short)ReadU16(reader);
+        entity->y = (unsigned short)ReadU16(reader);
+    }
+    if (fields & NET_FIELD_ROTATION) entity->rotation = (unsigned short)ReadU16(reader);
+    if (fields & NET_FIELD_TYPE) entity->type = (unsigned char)ReadU8(reader);
+
+    entity->active = 1;
+}
+
+static void WriteU8(NetWriter *writer, unsigned int value)
+{
+    if (writer->size >= writer->capacity)
+    {
+        writer->overflow = true;
+        return;
+    }
+
+    writer->data[writer->size++] = (unsigned char)value;
+}
+
+static void WriteU16(NetWriter *writer, unsigned int value)
+{
+    WriteU8(writer, value & 0xff);
+    WriteU8(writer, (value >> 8) & 0xff);
+}
+
+static void WriteU32(NetWriter *writer, unsigned int value)
+{
+    WriteU16(writer, value & 0xffff);
+    WriteU16(writer, (value >> 16) & 0xffff);
+}
+
+static unsigned int ReadU8(NetReader *reader)
+{
+    if (reader->position >= reader->size)
+    {
+        reader->overflow = true;
+        return 0;
+    }
+
+    return reader->data[reader->position++];
+}
+
+static unsigned int ReadU16(NetReader *reader)
+{
+    unsigned int low = ReadU8(reader);
+
+    return low | (ReadU8(reader) << 8);
+}
+
+static unsigned int ReadU32(NetReader *reader)
+{
+    unsigned int low = ReadU16(reader);
+
+    return low | (ReadU16(reader) << 16);
+}
+
+// Get game entity by network entity index
+static sEntity *GetEntity(GameState *game, int index)
+{
+    if (index == NET_ENTITY_PLAYER) return &game->sPlayer;
+    if (index == NET_ENTITY_BEAM) return &game->sSuperBeam;
+    if (index < NET_ENTITY_ASTEROIDS) return &game->sShots[index - NET_ENTITY_SHOTS];
+
+    return &game->sAsteroids[index - NET_ENTITY_ASTEROIDS];
+}
+
+static float GetPosition(unsigned short value)
+{
+    return (float)value/NET_POSITION_SCALE - NET_POSITION_MARGIN;
+}
+
+// Interpolate position, the short way around when it wrapped between states
+static float LerpPosition(float from, float to, float amount, float size)
+{
+    float delta = to - from;
+
+    if (fabsf(delta) <= size/2) return from + delta*amount;
+
+    delta += (delta > 0.0f)? -size : size;
+    float position = from + delta*amount;
+
+    if (position < 0.0f) position += size;
+    else if (position > size) position -= size;
+
+    return position;
+}
+
+// Interpolate angle in degrees, the short way around
+static float LerpAngle(unsigned short from, unsigned short to, float amount)
+{
+    int delta = ((int)to - (int)from) & 0xffff;
+    if (delta >= 32768) delta -= 65536;
+
+    return ((float)from + (float)delta*amount)*360.0f/65536.0f;
+}
+
+// Simulation values travel as their raw 32 bits, float or fixed point
+static void WriteSim(NetWriter *writer, SimValue value)
+{
+    unsigned int bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+
+    WriteU32(writer, bits);
+}
+
+static SimValue ReadSim(NetReader *reader)
+{
+    unsigned int bits = ReadU32(reader);
+    SimValue value = 0;
+    memcpy(&value, &bits, sizeof(value));
+
+    return value;
+}
+
+static void WritePilotEntity(NetWriter *writer, const sEntity *entity, bool lifetime)
+{
+    WriteSim(writer, entity->position.x);
+    WriteSim(writer, entity->position.y);
+    WriteSim(writer, entity->speed.x);
+    WriteSim(writer, entity->speed.y);
+    WriteSim(writer, entity->rotation);
+    WriteSim(writer, entity->acceleration);
+    if (lifetime) WriteSim(writer, entity->lifetime);
+}
+
+static void ReadPilotEntity(NetReader *reader, sEntity *entity, bool lifetime)
+{
+    entity->position.x = ReadSim(reader);
+    entity->position.y = ReadSim(reader);
+    entity->speed.x = ReadSim(reader);
+    entity->speed.y = ReadSim(reader);
+    entity->rotation = ReadSim(reader);
+    entity->acceleration = ReadSim(reader);
+    if (lifetime) entity->lifetime = ReadSim(reader);
+}
+
+static void SetPilotEntity(sEntity *entity, const sEntity *pilot)
+{
+    entity->position = pilot->position;
+    entity->speed = pilot->speed;
+    entity->rotation = pilot->rotation;
+    entity->acceleration = pilot->acceleration;
+    entity->lifetime = pilot->lifetime;
+    entity->active = pilot->active;
+}
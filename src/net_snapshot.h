@@ -0,0 +1,118 @@
+/*******************************************************************************************
+*
+*   net_snapshot - Quantized game state for network replication, delta compressed
+*
+*   The host captures what clients need to draw every network tick as a NetState: entity
+*   positions quantized to 1/NET_POSITION_SCALE pixel, angles to 16 bits, HUD values to
+*   integers. Simulation internals (speeds, timers, chunk ticks, RNG) stay on the host.
+*
+*   A state is sent as a delta against a baseline, the newest state the client acknowledged,
+*   so only entities that changed since then are written: a bitmask marks changed entities
+*   (player, beam, shots and asteroids by slot) and each changed entity carries only the
+*   fields that changed, small moves as signed byte offsets. Without a baseline the delta
+*   is written against the empty state, everything inactive. Most asteroids away from the
+*   player are frozen (see CHUNK_REDUCED_RATE_RADIUS) and cost a bitmask bit.
+*
+*   Clients keep received states and draw in between two of them, see NetStateApply().
+*
+*   The client flying the ship also gets a NetPilotState: exact player ship and shots after
+*   the last input of that client the host applied. Client prediction restarts from it and
+*   replays the inputs the host did not apply yet, quantized values would drift on replay.
+*
+*   DELTA FORMAT (little-endian, byte aligned):
+*       u32 tick, u32 baselineTick          baselineTick is NET_NO_BASELINE against the empty state
+*       u32 asteroidScore, u8 lives, u16 beamCharge, u8 flags
+*       u8 changed[(NET_ENTITY_COUNT + 7)/8]
+*       { u8 fields, [i8 dx, i8 dy], [u16 x, u16 y], [u16 rotation], [u8 type] }[changed count]
+*
+*   PILOT FORMAT (little-endian, simulation values as raw 32 bits):
+*       u32 inputSequence, u8 isGameOver
+*       player { position.x, position.y, speed.x, speed.y, rotation, acceleration }
+*       u16 activeShots, shot { position.x, position.y, speed.x, speed.y, rotation, acceleration, lifetime }[active count]
+*
+********************************************************************************************/
+
+#ifndef NET_SNAPSHOT_H
+#define NET_SNAPSHOT_H
+
+#include "gameplay.h"                       // Required for: GameState, MAX_SHOTS, MAX_ASTEROIDS
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define NET_NO_BASELINE             0       // Network ticks start at 1
+
+#if !defined(NET_POSITION_SCALE)
+    #define NET_POSITION_SCALE      4       // Quantized position steps per pixel
+#endif
+#define NET_POSITION_MARGIN         1024    // Pixels out of the world that can be sent, the beam is not wrapped
+#define NET_CHARGE_SCALE            100     // Quantized beam charge steps per unit
+
+// Entities by index: player, beam, shots, asteroids
+#define NET_ENTITY_PLAYER           0
+#define NET_ENTITY_BEAM             1
+#define NET_ENTITY_SHOTS            2
+#define NET_ENTITY_ASTEROIDS        (NET_ENTITY_SHOTS + MAX_SHOTS)
+#define NET_ENTITY_COUNT            (NET_ENTITY_ASTEROIDS + MAX_ASTEROIDS)
+
+// State flags
+#define NET_STATE_GAME_OVER         0x01
+#define NET_STATE_PRE_DETONATION    0x02
+#define NET_STATE_INVINCIBLE        0x04
+
+// Largest delta, every entity changed with every field
+#define NET_DELTA_MAX_SIZE          (16 + (NET_ENTITY_COUNT + 7)/8 + NET_ENTITY_COUNT*8)
+#define NET_PILOT_MAX_SIZE          (5 + 6*4 + 2 + MAX_SHOTS*7*4)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    unsigned short x;                       // (position + NET_POSITION_MARGIN)*NET_POSITION_SCALE
+    unsigned short y;
+    unsigned short rotation;                // 65536 steps per turn
+    unsigned char type;
+    unsigned char active;                   // Inactive entities are all zeros
+} NetEntity;
+
+typedef struct {
+    unsigned int tick;                      // Host network tick
+    unsigned int asteroidScore;
+    unsigned char lives;
+    unsigned short beamCharge;              // beamCharge*NET_CHARGE_SCALE
+    unsigned char flags;                    // NET_STATE_*
+    NetEntity entities[NET_ENTITY_COUNT];
+} NetState;
+
+// Exact player ship and shots, sent to the client flying the ship
+typedef struct {
+    unsigned int inputSequence;             // Last input of the client applied by the host, 0 if none
+    bool isGameOver;
+    sEntity player;
+    sEntity shots[MAX_SHOTS];
+} NetPilotState;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void NetStateCapture(const GameState *game, unsigned int tick, NetState *state);   // Quantize game state for sending
+int NetStateWriteDelta(const NetState *baseline, const NetState *state, unsigned char *buffer, int bufferSize);    // Write state against baseline (NULL for none), returns size, 0 if it does not fit
+bool NetStateReadTicks(const unsigned char *data, int size, unsigned int *tick, unsigned int *baselineTick);     // Get delta tick and the baseline it needs
+bool NetStateReadDelta(const NetState *baseline, const unsigned char *data, int size, NetState *state);         // Read delta against its baseline (NULL for none), false if invalid
+bool NetEntityIsValid(int index, const NetEntity *entity);     // Check entity type fits its kind, received types index sprite rectangles
+void NetStateApply(GameState *game, const NetState *from, const NetState *to, float amount);   // Set game for drawing, interpolated between two states
+
+void NetPilotCapture(const GameState *game, unsigned int inputSequence, NetPilotState *pilot);
+int NetPilotWrite(const NetPilotState *pilot, unsigned char *buffer, int bufferSize);   // Returns size, 0 if it does not fit
+int NetPilotRead(const unsigned char *data, int size, NetPilotState *pilot);          // Returns size read, 0 if invalid
+void NetPilotApply(GameState *game, const NetPilotState *pilot);                      // Set player ship and shots, prediction starts from there
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // NET_SNAPSHOT_H
@@ -0,0 +1,227 @@
+/*******************************************************************************************
+*
+*   net_socket - Non-blocking UDP sockets on the loopback interface
+*
+*   NOTE: Datagrams from other addresses are dropped on receive, binding to 127.0.0.1
+*   already keeps them out on every supported platform
+*
+*   NOTE: This module does not include raylib.h on purpose, winsock2.h conflicts with it
+*
+********************************************************************************************/
+
+#include "net_socket.h"
+
+#include <string.h>                         // Required for: memset()
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <winsock2.h>                   // Required for: socket(), bind(), sendto(), recvfrom(), ioctlsocket()
+    #include <ws2tcpip.h>                   // Required for: socklen_t
+    #include <windows.h>                    // Required for: QueryPerformanceCounter(), QueryPerformanceFrequency()
+    #if defined(_MSC_VER)
+        #pragma comment(lib, "ws2_32.lib")
+    #endif
+    #define NET_SOCKETS
+#elif !defined(PLATFORM_WEB)
+    #include <sys/socket.h>                 // Required for: socket(), bind(), sendto(), recvfrom()
+    #include <netinet/in.h>                 // Required for: sockaddr_in, INADDR_LOOPBACK
+    #include <arpa/inet.h>                  // Required for: htons(), htonl()
+    #include <fcntl.h>                      // Required for: fcntl()
+    #include <unistd.h>                     // Required for: close()
+    #include <time.h>                       // Required for: clock_gettime()
+    #define NET_SOCKETS
+#else
+    #include <time.h>                       // Required for: clock_gettime()
+#endif
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+#if defined(_WIN32)
+static bool winsockReady = false;
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+#if defined(NET_SOCKETS)
+static struct sockaddr_in GetLoopbackAddress(unsigned short port);
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+#if defined(NET_SOCKETS)
+bool NetSocketOpen(NetSocket *sock, unsigned short port)
+{
+    sock->handle = -1;
+    sock->port = 0;
+
+#if defined(_WIN32)
+    if (!winsockReady)
+    {
+        WSADATA data = { 0 };
+        if (WSAStartup(MAKEWORD(2, 2), &data) != 0) return false;
+        winsockReady = true;
+    }
+
+    SOCKET handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (handle == INVALID_SOCKET) return false;
+
+    u_long nonBlocking = 1;
+    bool ready = (ioctlsocket(handle, FIONBIO, &nonBlocking) == 0);
+#else
+    int handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (handle < 0) return false;
+
+    bool ready = (fcntl(handle, F_SETFL, fcntl(handle, F_GETFL, 0) | O_NONBLOCK) == 0);
+#endif
+
+    struct sockaddr_in address = GetLoopbackAddress(port);
+    socklen_t addressSize = sizeof(address);
+
+    ready = ready && (bind(handle, (struct sockaddr *)&address, sizeof(address)) == 0);
+    ready = ready && (getsockname(handle, (struct sockaddr *)&address, &addressSize) == 0);
+
+    if (!ready)
+    {
+#if defined(_WIN32)
+        closesocket(handle);
+#else
+        close(handle);
+#endif
+        return false;
+    }
+
+    sock->handle = (long long)handle;
+    sock->port = ntohs(address.sin_port);
+
+    return true;
+}
+
+void NetSocketClose(NetSocket *sock)
+{
+    if (sock->handle < 0) return;
+
+#if defined(_WIN32)
+    closesocket((SOCKET)sock->handle);
+#else
+    close((int)sock->handle);
+#endif
+
+    sock->handle = -1;
+    sock->port = 0;
+}
+
+bool NetSocketSend(NetSocket *sock, unsigned short port, const void *data, int size)
+{
+    if ((sock->handle < 0) || (size <= 0) || (size > NET_SOCKET_MAX_PACKET)) return false;
+
+    struct sockaddr_in address = GetLoopbackAddress(port);
+
+#if defined(_WIN32)
+    int sent = sendto((SOCKET)sock->handle, (const char *)data, size, 0, (struct sockaddr *)&address, sizeof(address));
+#else
+    int sent = (int)sendto((int)sock->handle, data, (size_t)size, 0, (struct sockaddr *)&address, sizeof(address));
+#endif
+
+    return (sent == size);
+}
+
+int NetSocketReceive(NetSocket *sock, void *buffer, int bufferSize, unsigned short *port)
+{
+    if (sock->handle < 0) return 0;
+
+    while (true)
+    {
+        struct sockaddr_in address = { 0 };
+        socklen_t addressSize = sizeof(address);
+
+#if defined(_WIN32)
+        int size = recvfrom((SOCKET)sock->handle, (char *)buffer, bufferSize, 0, (struct sockaddr *)&address, &addressSize);
+
+        // Windows reports ICMP port unreachable from an earlier send as a receive error, skip it
+        if ((size < 0) && (WSAGetLastError() == WSAECONNRESET)) continue;
+#else
+        int size = (int)recvfrom((int)sock->handle, buffer, (size_t)bufferSize, 0, (struct sockaddr *)&address, &addressSize);
+#endif
+
+        // Nothing waiting (would block) or receive error
+        if (size <= 0) return 0;
+        if (address.sin_addr.s_addr != htonl(INADDR_LOOPBACK)) continue;
+
+        if (port != NULL) *port = ntohs(address.sin_port);
+
+        return size;
+    }
+}
+#else
+bool NetSocketOpen(NetSocket *sock, unsigned short port)
+{
+    (void)port;
+
+    sock->handle = -1;
+    sock->port = 0;
+
+    return false;
+}
+
+void NetSocketClose(NetSocket *sock)
+{
+    (void)sock;
+}
+
+bool NetSocketSend(NetSocket *sock, unsigned short port, const void *data, int size)
+{
+    (void)sock;
+    (void)port;
+    (void)data;
+    (void)size;
+
+    return false;
+}
+
+int NetSocketReceive(NetSocket *sock, void *buffer, int bufferSize, unsigned short *port)
+{
+    (void)sock;
+    (void)buffer;
+    (void)bufferSize;
+    (void)port;
+
+    return 0;
+}
+#endif // NET_SOCKETS
+
+double NetGetTime(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter = { 0 };
+    LARGE_INTEGER frequency = { 0 };
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+
+    return (double)counter.QuadPart/(double)frequency.QuadPart;
+#else
+    struct timespec now = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec + (double)now.tv_nsec*1e-9;
+#endif
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+#if defined(NET_SOCKETS)
+static struct sockaddr_in GetLoopbackAddress(unsigned short port)
+{
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+
+    return address;
+}
+#endif
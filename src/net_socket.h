@@ -0,0 +1,51 @@
+/*******************************************************************************************
+*
+*   net_socket - Non-blocking UDP sockets on the loopback interface
+*
+*   Sockets are bound to 127.0.0.1 and only talk to 127.0.0.1, peers are identified by
+*   their port. Networked play can be tested on a single offline machine, nothing is
+*   exposed to other hosts.
+*
+*   Wraps BSD sockets on POSIX systems and Winsock on Windows. Web builds have no UDP,
+*   NetSocketOpen() returns false there.
+*
+*   NOTE: This module does not include raylib.h on purpose, winsock2.h conflicts with it
+*
+********************************************************************************************/
+
+#ifndef NET_SOCKET_H
+#define NET_SOCKET_H
+
+#include <stdbool.h>                        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define NET_SOCKET_MAX_PACKET       65507   // Largest UDP payload
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    long long handle;                       // Platform socket, -1 if not open
+    unsigned short port;                    // Bound local port
+} NetSocket;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool NetSocketOpen(NetSocket *sock, unsigned short port);                 // Bind to 127.0.0.1:port, 0 picks a free port
+void NetSocketClose(NetSocket *sock);
+bool NetSocketSend(NetSocket *sock, unsigned short port, const void *data, int size);    // Send datagram to 127.0.0.1:port
+int NetSocketReceive(NetSocket *sock, void *buffer, int bufferSize, unsigned short *port);   // Get next datagram, returns size, 0 if none waiting
+double NetGetTime(void);                                                    // Get monotonic time in seconds, does not require a window
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // NET_SOCKET_H
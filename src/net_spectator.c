@@ -0,0 +1,612 @@
+/*******************************************************************************************
+*
+*   net_spectator - Spectator streams with interest management over loopback UDP
+*
+*   NOTE: Entity values are quantized once per tick with NetStateCapture() and shared by
+*   every spectator, only relevance, ranking and writing are per spectator
+*
+*   NOTE: Spectators get no interpolation, close entities are sent every tick and distant
+*   ones move in steps, it is what the budget buys
+*
+********************************************************************************************/
+
+#include "net_spectator.h"
+#include "net_snapshot.h"                   // Required for: NetState, NetEntity, NetStateCapture(), NetStateApply(), NetEntityIsValid()
+#include "net_session.h"                    // Required for: NET_PROTOCOL_ID, NET_TIMEOUT
+#include "net_socket.h"                     // Required for: NetSocket, NetSocketSend(), NetSocketReceive(), NetGetTime()
+
+#include <stdlib.h>                         // Required for: qsort(), abs()
+#include <string.h>                         // Required for: memset()
+#include <math.h>                           // Required for: floorf(), fabsf(), sqrtf()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define NET_HEADER_SIZE             3
+#define NET_STATE_HEADER_SIZE       12      // Tick, score, lives, flags and record count
+#define NET_RECORD_SIZE             9       // Entity index and values
+#define NET_REMOVAL_SIZE            2       // Entity index only
+
+#define NET_PRIORITY_NEW            1000.0f // Entities the spectator does not have yet, type changes and removals
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    bool active;
+    unsigned short port;
+    double lastReceiveTime;
+    Vector2 center;                         // View center, world pixels
+    Vector2 extent;                         // View half size plus margin, world pixels
+    NetEntity known[NET_ENTITY_COUNT];      // Last values sent, inactive if the spectator does not have it
+    unsigned int sentTick[NET_ENTITY_COUNT];
+} NetSpectator;
+
+typedef struct {
+    float priority;
+    int entity;                             // Entity index, NET_SPECTATOR_REMOVED set for removals
+} NetCandidate;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static unsigned char packet[NET_SOCKET_MAX_PACKET] = { 0 };    // Scratch for sent and received packets
+
+// Host
+static NetSocket hostSocket = { -1, 0 };
+static NetSpectator spectators[NET_MAX_SPECTATORS] = { 0 };
+static NetState current = { 0 };            // This tick entities, quantized once for every spectator
+static unsigned int hostTick = 0;
+static NetCandidate candidates[NET_ENTITY_COUNT] = { 0 };     // Scratch for the spectator being written
+static int candidateCount = 0;
+static unsigned int relevantStamp[NET_ENTITY_COUNT] = { 0 };  // Stamp of the last spectator the entity was relevant for
+static unsigned int stamp = 0;
+static NetSpectatorHostStats hostStats = { 0 };
+static int hostWindowTicks = 0;             // Stats being accumulated for the next hostStats
+static int hostWindowSends = 0;
+static int hostWindowBytes = 0;
+static double hostWindowEncodeTime = 0.0;
+static int hostWindowRelevant = 0;
+static int hostWindowSent = 0;
+static int hostWindowDeferred = 0;
+
+// Spectator
+static NetSocket spectatorSocket = { -1, 0 };
+static unsigned short hostPort = 0;
+static NetState view = { 0 };               // Entities known, drawn as they are
+static unsigned int entityTicks[NET_ENTITY_COUNT] = { 0 };    // Host tick of each entity values
+static unsigned int newestTick = 0;
+static double lastReceiveTime = 0.0;
+static NetSpectatorStats stats = { 0 };
+static double windowStart = 0.0;            // Stats being accumulated for the next stats
+static int windowBytes = 0;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void ReceiveSpectatorPackets(double time);
+static NetSpectator *GetSpectator(unsigned short port, bool create);
+static void SendSpectatorState(NetSpectator *spectator, const GameState *game);
+static void AddCandidate(NetSpectator *spectator, int entity, SimVector2 position);
+static bool GetViewDistance(const NetSpectator *spectator, SimVector2 position, float *distance);
+static void GetChunkSpan(float from, float to, int worldSize, int chunkCount, bool *span);
+static int CompareCandidates(const void *a, const void *b);
+static void UpdateHostStats(void);
+static unsigned int GetViewValue(float value);
+static void ReceiveHostPackets(double time);
+static int WriteHeader(unsigned char *data, int type);
+static bool IsValidHeader(const unsigned char *data, int size);
+static void WriteU16(unsigned char *data, unsigned int value);
+static void WriteU32(unsigned char *data, unsigned int value);
+static unsigned int ReadU16(const unsigned char *data);
+static unsigned int ReadU32(const unsigned char *data);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+bool NetSpectatorHostStart(unsigned short port)
+{
+    NetSpectatorHostStop();
+
+    if (!NetSocketOpen(&hostSocket, port))
+    {
+        TraceLog(LOG_WARNING, "NET: Failed to listen for spectators on 127.0.0.1:%i", port);
+        return false;
+    }
+
+    hostTick = 0;
+    hostStats = (NetSpectatorHostStats){ 0 };
+    TraceLog(LOG_INFO, "NET: Spectators on 127.0.0.1:%i", hostSocket.port);
+
+    return true;
+}
+
+void NetSpectatorHostStop(void)
+{
+    NetSocketClose(&hostSocket);
+
+    for (int i = 0; i < NET_MAX_SPECTATORS; i++) spectators[i].active = false;
+}
+
+void NetSpectatorHostUpdate(const GameState *game)
+{
+    if (hostSocket.handle < 0) return;
+
+    ReceiveSpectatorPackets(NetGetTime());
+
+    hostTick++;
+    bool captured = false;
+
+    for (int i = 0; i < NET_MAX_SPECTATORS; i++)
+    {
+        if (!spectators[i].active) continue;
+
+        double start = NetGetTime();
+
+        if (!captured) NetStateCapture(game, hostTick, &current);
+        captured = true;
+
+        SendSpectatorState(&spectators[i], game);
+        hostWindowEncodeTime += NetGetTime() - start;
+    }
+
+    hostWindowTicks++;
+    if (hostWindowTicks >= GAME_TICK_RATE) UpdateHostStats();
+}
+
+NetSpectatorHostStats NetSpectatorHostGetStats(void)
+{
+    return hostStats;
+}
+
+bool NetSpectatorStart(unsigned short port)
+{
+    NetSpectatorStop();
+
+    if (!NetSocketOpen(&spectatorSocket, 0))
+    {
+        TraceLog(LOG_WARNING, "NET: Failed to open spectator socket");
+        return false;
+    }
+
+    hostPort = port;
+    memset(&view, 0, sizeof(view));
+    memset(entityTicks, 0, sizeof(entityTicks));
+    newestTick = 0;
+    lastReceiveTime = 0.0;
+    stats = (NetSpectatorStats){ 0 };
+    windowStart = NetGetTime();
+    windowBytes = 0;
+
+    TraceLog(LOG_INFO, "NET: Spectating 127.0.0.1:%i", port);
+
+    return true;
+}
+
+void NetSpectatorStop(void)
+{
+    if (spectatorSocket.handle < 0) return;
+
+    NetSocketSend(&spectatorSocket, hostPort, packet, WriteHeader(packet, NET_PACKET_SPECTATOR_LEAVE));
+    NetSocketClose(&spectatorSocket);
+}
+
+bool NetSpectatorUpdate(GameState *game, Vector2 center)
+{
+    if (spectatorSocket.handle < 0) return false;
+
+    double time = NetGetTime();
+
+    ReceiveHostPackets(time);
+
+    // View sent every frame, also connects and keeps the spectator alive
+    float scale = (game->viewScale > 0.0f)? game->viewScale : 1.0f;
+    float width = game->viewSize.x/scale;
+    float height = game->viewSize.y/scale;
+    int size = WriteHeader(packet, NET_PACKET_SPECTATOR_VIEW);
+
+    WriteU16(packet + size, GetViewValue(center.x));
+    WriteU16(packet + size + 2, GetViewValue(center.y));
+    WriteU16(packet + size + 4, GetViewValue(width));
+    WriteU16(packet + size + 6, GetViewValue(height));
+    NetSocketSend(&spectatorSocket, hostPort, packet, size + 8);
+
+    stats.connected = (lastReceiveTime > 0.0) && ((time - lastReceiveTime) < NET_TIMEOUT);
+
+    if ((time - windowStart) >= 1.0)
+    {
+        stats.bytesPerSecond = (float)(windowBytes/(time - windowStart));
+        windowStart = time;
+        windowBytes = 0;
+    }
+
+    if (newestTick == 0) return false;
+
+    // Entities whose removal was lost, player ship is always sent
+    stats.entities = 0;
+
+    for (int i = 0; i < NET_ENTITY_COUNT; i++)
+    {
+        if (!view.entities[i].active) continue;
+
+        if ((i != NET_ENTITY_PLAYER) && ((newestTick - entityTicks[i]) > NET_SPECTATOR_EXPIRE_TICKS)) view.entities[i] = (NetEntity){ 0 };
+        else stats.entities++;
+    }
+
+    NetStateApply(game, &view, &view, 1.0f);
+    game->camera.target = center;           // Free camera, not following the player
+
+    return true;
+}
+
+NetSpectatorStats NetSpectatorGetStats(void)
+{
+    return stats;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Handle spectator views and leaves, drop spectators gone silent
+static void ReceiveSpectatorPackets(double time)
+{
+    unsigned short port = 0;
+    int size = 0;
+
+    while ((size = NetSocketReceive(&hostSocket, packet, sizeof(packet), &port)) > 0)
+    {
+        if (!IsValidHeader(packet, size)) continue;
+
+        NetSpectator *spectator = GetSpectator(port, (packet[2] == NET_PACKET_SPECTATOR_VIEW));
+        if (spectator == NULL) continue;
+
+        if (packet[2] == NET_PACKET_SPECTATOR_LEAVE)
+        {
+            spectator->active = false;
+            TraceLog(LOG_INFO, "NET: Spectator 127.0.0.1:%i left", port);
+        }
+        else if ((packet[2] == NET_PACKET_SPECTATOR_VIEW) && (size >= (NET_HEADER_SIZE + 8)))
+        {
+            spectator->center = (Vector2){ (float)ReadU16(packet + NET_HEADER_SIZE), (float)ReadU16(packet + NET_HEADER_SIZE + 2) };
+            spectator->extent = (Vector2){ ReadU16(packet + NET_HEADER_SIZE + 4)/2.0f + NET_SPECTATOR_MARGIN, ReadU16(packet + NET_HEADER_SIZE + 6)/2.0f + NET_SPECTATOR_MARGIN };
+            spectator->lastReceiveTime = time;
+        }
+    }
+
+    for (int i = 0; i < NET_MAX_SPECTATORS; i++)
+    {
+        if (spectators[i].active && ((time - spectators[i].lastReceiveTime) > NET_TIMEOUT))
+        {
+            spectators[i].active = false;
+            TraceLog(LOG_INFO, "NET: Spectator 127.0.0.1:%i timed out", spectators[i].port);
+        }
+    }
+}
+
+// Find spectator by port, a free slot is taken for new spectators if create is set
+static NetSpectator *GetSpectator(unsigned short port, bool create)
+{
+    NetSpectator *freeSpectator = NULL;
+
+    for (int i = 0; i < NET_MAX_SPECTATORS; i++)
+    {
+        if (spectators[i].active && (spectators[i].port == port)) return &spectators[i];
+        if (!spectators[i].active && (freeSpectator == NULL)) freeSpectator = &spectators[i];
+    }
+
+    if (!create || (freeSpectator == NULL)) return NULL;
+
+    // Spectator starts with nothing, everything relevant is new
+    freeSpectator->active = true;
+    freeSpectator->port = port;
+    memset(freeSpectator->known, 0, sizeof(freeSpectator->known));
+    memset(freeSpectator->sentTick, 0, sizeof(freeSpectator->sentTick));
+    TraceLog(LOG_INFO, "NET: Spectator 127.0.0.1:%i joined", port);
+
+    return freeSpectator;
+}
+
+// Gather entities around the spectator view, rank them and send what fits the budget
+static void SendSpectatorState(NetSpectator *spectator, const GameState *game)
+{
+    stamp++;
+    if (stamp == 0)
+    {
+        memset(relevantStamp, 0, sizeof(relevantStamp));
+        stamp = 1;
+    }
+
+    candidateCount = 0;
+
+    // Player ship always, shots and beam by distance
+    AddCandidate(spectator, NET_ENTITY_PLAYER, game->sPlayer.position);
+    if (game->sSuperBeam.active) AddCandidate(spectator, NET_ENTITY_BEAM, game->sSuperBeam.position);
+    for (int i = 0; i < MAX_SHOTS; i++) if (game->sShots[i].active) AddCandidate(spectator, NET_ENTITY_SHOTS + i, game->sShots[i].position);
+
+    // Asteroids from the chunks under the view only
+    bool columns[CHUNKS_X] = { 0 };
+    bool rows[CHUNKS_Y] = { 0 };
+
+    GetChunkSpan(spectator->center.x - spectator->extent.x, spectator->center.x + spectator->extent.x, WORLD_WIDTH, CHUNKS_X, columns);
+    GetChunkSpan(spectator->center.y - spectator->extent.y, spectator->center.y + spectator->extent.y, WORLD_HEIGHT, CHUNKS_Y, rows);
+
+    for (int cy = 0; cy < CHUNKS_Y; cy++)
+    {
+        if (!rows[cy]) continue;
+
+        for (int cx = 0; cx < CHUNKS_X; cx++)
+        {
+            if (!columns[cx]) continue;
+
+            for (int i = game->chunkFirst[cy*CHUNKS_X + cx]; i != -1; i = game->asteroidNext[i]) AddCandidate(spectator, NET_ENTITY_ASTEROIDS + i, game->sAsteroids[i].position);
+        }
+    }
+
+    // Entities the spectator has that died or left the view
+    for (int i = 0; i < NET_ENTITY_COUNT; i++)
+    {
+        if (spectator->known[i].active && (relevantStamp[i] != stamp)) candidates[candidateCount++] = (NetCandidate){ NET_PRIORITY_NEW, i | NET_SPECTATOR_REMOVED };
+    }
+
+    qsort(candidates, candidateCount, sizeof(NetCandidate), CompareCandidates);
+
+    // Highest priority first until the budget is spent, the rest waits and gains priority
+    int size = WriteHeader(packet, NET_PACKET_SPECTATOR_STATE);
+    int recordsOffset = size + NET_STATE_HEADER_SIZE;
+    int budgetEnd = recordsOffset + NET_SPECTATOR_BUDGET;
+    int count = 0;
+
+    size = recordsOffset;
+
+    for (int c = 0; c < candidateCount; c++)
+    {
+        int entity = candidates[c].entity & ~NET_SPECTATOR_REMOVED;
+        bool removal = (candidates[c].entity & NET_SPECTATOR_REMOVED) != 0;
+
+        if ((size + (removal? NET_REMOVAL_SIZE : NET_RECORD_SIZE)) > budgetEnd)
+        {
+            hostWindowDeferred += candidateCount - c;
+            break;
+        }
+
+        WriteU16(packet + size, (unsigned int)candidates[c].entity);
+        size += NET_REMOVAL_SIZE;
+
+        if (removal) spectator->known[entity] = (NetEntity){ 0 };
+        else
+        {
+            const NetEntity *values = &current.entities[entity];
+
+            WriteU16(packet + size, values->x);
+            WriteU16(packet + size + 2, values->y);
+            WriteU16(packet + size + 4, values->rotation);
+            packet[size + 6] = values->type;
+            size += NET_RECORD_SIZE - NET_REMOVAL_SIZE;
+
+            spectator->known[entity] = *values;
+        }
+
+        spectator->sentTick[entity] = hostTick;
+        count++;
+    }
+
+    WriteU32(packet + NET_HEADER_SIZE, hostTick);
+    WriteU32(packet + NET_HEADER_SIZE + 4, current.asteroidScore);
+    packet[NET_HEADER_SIZE + 8] = current.lives;
+    packet[NET_HEADER_SIZE + 9] = current.flags;
+    WriteU16(packet + NET_HEADER_SIZE + 10, (unsigned int)count);
+
+    NetSocketSend(&hostSocket, spectator->port, packet, size);
+
+    hostWindowSends++;
+    hostWindowBytes += size;
+    hostWindowSent += count;
+}
+
+// Mark entity relevant, it is a candidate if the spectator does not have its current values
+// NOTE: Priority is the drift from the values sent, in pixels, weighted by closeness
+static void AddCandidate(NetSpectator *spectator, int entity, SimVector2 position)
+{
+    float distance = 0.0f;
+    if ((entity != NET_ENTITY_PLAYER) && !GetViewDistance(spectator, position, &distance)) return;
+
+    relevantStamp[entity] = stamp;
+    hostWindowRelevant++;
+
+    const NetEntity *values = &current.entities[entity];
+    const NetEntity *known = &spectator->known[entity];
+    float priority = 0.0f;
+
+    if (!known->active || (known->type != values->type)) priority = NET_PRIORITY_NEW;
+    else
+    {
+        int turn = abs((int)values->rotation - (int)known->rotation);
+        if (turn > 32768) turn = 65536 - turn;
+
+        priority = (float)(abs((int)values->x - (int)known->x) + abs((int)values->y - (int)known->y))/NET_POSITION_SCALE;
+        priority += (float)turn*360.0f/65536.0f/8.0f;   // Degrees count less than pixels
+
+        // Unchanged entities are sent again once in a while, in case a record was lost
+        unsigned int age = hostTick - spectator->sentTick[entity];
+        if (age >= NET_SPECTATOR_REFRESH_TICKS) priority += (float)(age - NET_SPECTATOR_REFRESH_TICKS + 1);
+    }
+
+    if (priority <= 0.0f) return;
+
+    candidates[candidateCount++] = (NetCandidate){ priority/(1.0f + distance/CHUNK_SIZE), entity };
+}
+
+// Get distance from view center on the wrapped world, false if out of the view and margin
+static bool GetViewDistance(const NetSpectator *spectator, SimVector2 position, float *distance)
+{
+    float dx = SIM_TO_FLOAT(position.x) - spectator->center.x;
+    float dy = SIM_TO_FLOAT(position.y) - spectator->center.y;
+
+    dx -= floorf(dx/WORLD_WIDTH + 0.5f)*WORLD_WIDTH;
+    dy -= floorf(dy/WORLD_HEIGHT + 0.5f)*WORLD_HEIGHT;
+
+    if ((fabsf(dx) > spectator->extent.x) || (fabsf(dy) > spectator->extent.y)) return false;
+
+    *distance = sqrtf(dx*dx + dy*dy);
+
+    return true;
+}
+
+// Mark chunk columns (or rows) overlapped by a world range, the range wraps around the world
+static void GetChunkSpan(float from, float to, int worldSize, int chunkCount, bool *span)
+{
+    if ((to - from) >= (float)worldSize)
+    {
+        for (int i = 0; i < chunkCount; i++) span[i] = true;
+        return;
+    }
+
+    float length = to - from;
+    from -= floorf(from/worldSize)*worldSize;
+    to = from + length;
+
+    int last = (int)(((to < (float)worldSize)? to : (float)(worldSize - 1))/CHUNK_SIZE);
+    for (int i = (int)(from/CHUNK_SIZE); (i <= last) && (i < chunkCount); i++) span[i] = true;
+
+    // Range past the world end continues from the start
+    if (to >= (float)worldSize)
+    {
+        last = (int)((to - worldSize)/CHUNK_SIZE);
+        for (int i = 0; (i <= last) && (i < chunkCount); i++) span[i] = true;
+    }
+}
+
+// Sort by priority, highest first
+static int CompareCandidates(const void *a, const void *b)
+{
+    float priorityA = ((const NetCandidate *)a)->priority;
+    float priorityB = ((const NetCandidate *)b)->priority;
+
+    return (priorityA < priorityB) - (priorityA > priorityB);
+}
+
+static void UpdateHostStats(void)
+{
+    hostStats.spectators = 0;
+    for (int i = 0; i < NET_MAX_SPECTATORS; i++) if (spectators[i].active) hostStats.spectators++;
+
+    hostStats.bytesPerSecond = (float)hostWindowBytes*GAME_TICK_RATE/hostWindowTicks;
+    hostStats.encodeTime = (hostWindowSends > 0)? (float)(hostWindowEncodeTime/hostWindowSends) : 0.0f;
+    hostStats.relevant = (hostWindowSends > 0)? (float)hostWindowRelevant/hostWindowSends : 0.0f;
+    hostStats.sent = (hostWindowSends > 0)? (float)hostWindowSent/hostWindowSends : 0.0f;
+    hostStats.deferred = (hostWindowSends > 0)? (float)hostWindowDeferred/hostWindowSends : 0.0f;
+
+    hostWindowTicks = 0;
+    hostWindowSends = 0;
+    hostWindowBytes = 0;
+    hostWindowEncodeTime = 0.0;
+    hostWindowRelevant = 0;
+    hostWindowSent = 0;
+    hostWindowDeferred = 0;
+}
+
+// Get view value in the u16 range
+static unsigned int GetViewValue(float value)
+{
+    if (value < 0.0f) return 0;
+    if (value > 65535.0f) return 65535;
+
+    return (unsigned int)value;
+}
+
+// Apply entity records newer than the values known, packets can arrive out of order
+static void ReceiveHostPackets(double time)
+{
+    unsigned short port = 0;
+    int size = 0;
+
+    while ((size = NetSocketReceive(&spectatorSocket, packet, sizeof(packet), &port)) > 0)
+    {
+        if ((port != hostPort) || !IsValidHeader(packet, size) || (packet[2] != NET_PACKET_SPECTATOR_STATE)) continue;
+        if (size < (NET_HEADER_SIZE + NET_STATE_HEADER_SIZE)) continue;
+
+        unsigned int tick = ReadU32(packet + NET_HEADER_SIZE);
+        int count = (int)ReadU16(packet + NET_HEADER_SIZE + 10);
+
+        lastReceiveTime = time;
+        windowBytes += size;
+
+        if (tick > newestTick)
+        {
+            newestTick = tick;
+            view.tick = tick;
+            view.asteroidScore = ReadU32(packet + NET_HEADER_SIZE + 4);
+            view.lives = (packet[NET_HEADER_SIZE + 8] <= MAX_LIVES)? packet[NET_HEADER_SIZE + 8] : MAX_LIVES;
+            view.flags = packet[NET_HEADER_SIZE + 9];
+        }
+
+        int position = NET_HEADER_SIZE + NET_STATE_HEADER_SIZE;
+
+        for (int i = 0; (i < count) && ((position + NET_REMOVAL_SIZE) <= size); i++)
+        {
+            unsigned int record = ReadU16(packet + position);
+            int entity = (int)(record & ~NET_SPECTATOR_REMOVED);
+            bool removal = (record & NET_SPECTATOR_REMOVED) != 0;
+
+            position += NET_REMOVAL_SIZE;
+            if (!removal && ((position + NET_RECORD_SIZE - NET_REMOVAL_SIZE) > size)) break;
+            if (entity >= NET_ENTITY_COUNT) break;
+
+            NetEntity values = { 0 };
+
+            if (!removal)
+            {
+                values.x = (unsigned short)ReadU16(packet + position);
+                values.y = (unsigned short)ReadU16(packet + position + 2);
+                values.rotation = (unsigned short)ReadU16(packet + position + 4);
+                values.type = packet[position + 6];
+                values.active = 1;
+
+                if (!NetEntityIsValid(entity, &values)) break;     // Types index sprite rectangles
+            }
+
+            if (tick >= entityTicks[entity])
+            {
+                view.entities[entity] = values;
+                entityTicks[entity] = tick;
+            }
+
+            if (!removal) position += NET_RECORD_SIZE - NET_REMOVAL_SIZE;
+        }
+    }
+}
+
+static int WriteHeader(unsigned char *data, int type)
+{
+    data[0] = NET_PROTOCOL_ID;
+    data[1] = NET_SPECTATOR_PROTOCOL_VERSION;
+    data[2] = (unsigned char)type;
+
+    return NET_HEADER_SIZE;
+}
+
+static bool IsValidHeader(const unsigned char *data, int size)
+{
+    return (size >= NET_HEADER_SIZE) && (data[0] == NET_PROTOCOL_ID) && (data[1] == NET_SPECTATOR_PROTOCOL_VERSION);
+}
+
+static void WriteU16(unsigned char *data, unsigned int value)
+{
+    data[0] = (unsigned char)value;
+    data[1] = (unsigned char)(value >> 8);
+}
+
+static void WriteU32(unsigned char *data, unsigned int value)
+{
+    for (int i = 0; i < 4; i++) data[i] = (unsigned char)(value >> (8*i));
+}
+
+static unsigned int ReadU16(const unsigned char *data)
+{
+    return (unsigned int)data[0] | ((unsigned int)data[1] << 8);
+}
+
+static unsigned int ReadU32(const unsigned char *data)
+{
+    return (unsigned int)data[0] | ((unsigned int)data[1] << 8) | ((unsigned int)data[2] << 16) | ((unsigned int)data[3] << 24);
+}
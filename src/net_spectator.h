@@ -0,0 +1,100 @@
+/*******************************************************************************************
+*
+*   net_spectator - Spectator streams with interest management over loopback UDP
+*
+*   Spectators fly a free camera over the game run by a host and tell the host what they
+*   look at every frame. Instead of the whole state, each spectator only gets the entities
+*   around its view: asteroids are gathered from the chunks under the view (see chunk lists
+*   in GameState), shots and beam by distance, the player ship always.
+*
+*   Each spectator also gets a fixed byte budget per tick (NET_SPECTATOR_BUDGET). The host
+*   keeps, per spectator, the last values sent for every entity and ranks relevant entities
+*   by how far they drifted from them, weighted by closeness to the view center: close and
+*   fast entities are sent every tick, slow or distant ones when the budget allows. Frozen
+*   asteroids (see CHUNK_REDUCED_RATE_RADIUS) cost nothing once sent. Entities not sent for
+*   NET_SPECTATOR_REFRESH_TICKS gain priority, so every relevant entity is sent again now
+*   and then and lost packets heal. Entities dying or leaving the view are removed.
+*
+*   Records carry absolute values, no baseline or acknowledgment is needed. Spectators drop
+*   entities not refreshed for NET_SPECTATOR_EXPIRE_TICKS, in case a removal was lost.
+*
+*   Spectators connect to the host port + NET_SPECTATOR_PORT_OFFSET, start the game with
+*   --spectate [port] where port is the host one.
+*
+*   PACKET FORMAT:
+*       u8 NET_PROTOCOL_ID, u8 NET_SPECTATOR_PROTOCOL_VERSION, u8 packet type
+*       NET_PACKET_SPECTATOR_VIEW:  u16 centerX, u16 centerY, u16 width, u16 height, world pixels
+*       NET_PACKET_SPECTATOR_STATE: u32 tick, u32 asteroidScore, u8 lives, u8 flags, u16 count,
+*                                   { u16 entity, [u16 x, u16 y, u16 rotation, u8 type] }[count]
+*                                   entity has NET_SPECTATOR_REMOVED set for removals, no values
+*       NET_PACKET_SPECTATOR_LEAVE: No payload, spectator is leaving
+*
+********************************************************************************************/
+
+#ifndef NET_SPECTATOR_H
+#define NET_SPECTATOR_H
+
+#include "gameplay.h"                       // Required for: GameState
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define NET_SPECTATOR_PROTOCOL_VERSION  1
+#define NET_SPECTATOR_PORT_OFFSET       1       // Spectator port from host port
+
+// Packet types, after net_session and net_peer ones
+#define NET_PACKET_SPECTATOR_VIEW       8
+#define NET_PACKET_SPECTATOR_STATE      9
+#define NET_PACKET_SPECTATOR_LEAVE      10
+
+#define NET_MAX_SPECTATORS              32
+#if !defined(NET_SPECTATOR_BUDGET)
+    #define NET_SPECTATOR_BUDGET        256     // Entity bytes per spectator per tick, about 15 KB/s
+#endif
+#define NET_SPECTATOR_MARGIN            128     // Pixels around the view also sent, entities coming into view are already there
+#define NET_SPECTATOR_REFRESH_TICKS     30      // Unchanged entities are sent again after this, heals lost packets
+#define NET_SPECTATOR_EXPIRE_TICKS      120     // Spectators drop entities not refreshed for this long
+#define NET_SPECTATOR_REMOVED           0x8000  // Entity index flag, removal record
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Spectator host stats, averaged over the last second
+typedef struct {
+    int spectators;
+    float bytesPerSecond;                   // All spectators, packet bytes
+    float encodeTime;                       // Relevance, ranking and writing per spectator per tick, seconds
+    float relevant;                         // Entities around each spectator view, per tick
+    float sent;                             // Entity records sent per spectator per tick
+    float deferred;                         // Entities that changed but did not fit the budget, per spectator per tick
+} NetSpectatorHostStats;
+
+// Spectator stats, averaged over the last second
+typedef struct {
+    bool connected;                         // Host sent something recently
+    float bytesPerSecond;
+    int entities;                           // Entities known
+} NetSpectatorStats;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool NetSpectatorHostStart(unsigned short port);            // Listen for spectators on 127.0.0.1:port
+void NetSpectatorHostStop(void);
+void NetSpectatorHostUpdate(const GameState *game);         // Handle spectator packets and send this tick entities, call after every tick
+NetSpectatorHostStats NetSpectatorHostGetStats(void);
+
+bool NetSpectatorStart(unsigned short port);                // Watch host spectator port 127.0.0.1:port
+void NetSpectatorStop(void);
+bool NetSpectatorUpdate(GameState *game, Vector2 center);   // Send view centered on world position, set game for drawing, false until something arrives
+NetSpectatorStats NetSpectatorGetStats(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // NET_SPECTATOR_H
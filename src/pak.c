@@ -0,0 +1,92 @@
+/*******************************************************************************************
+*
+*   pak - Packed asset archive
+*
+********************************************************************************************/
+
+#include "raylib.h"                         // Required for: TraceLog()
+#include "pak.h"
+#include "mapped_file.h"
+
+#include <string.h>                         // Required for: memcmp(), memchr(), strncmp()
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static MappedFile pakFile = { 0 };
+static const PakEntry *pakEntries = NULL;
+static int pakCount = 0;
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+bool PakOpen(const char *fileName)
+{
+    PakClose();
+
+    pakFile = MapFile(fileName);
+    if (pakFile.data == NULL) return false;
+
+    const PakHeader *header = (const PakHeader *)pakFile.data;
+    bool valid = (pakFile.size >= sizeof(PakHeader)) &&
+                 (memcmp(header->magic, PAK_MAGIC, 4) == 0) &&
+                 (header->version == PAK_VERSION) &&
+                 (header->count <= (pakFile.size - sizeof(PakHeader))/sizeof(PakEntry));
+
+    // Validate every entry once so lookups can trust the index
+    const PakEntry *entries = (const PakEntry *)(pakFile.data + sizeof(PakHeader));
+
+    for (unsigned int i = 0; valid && (i < header->count); i++)
+    {
+        valid = (memchr(entries[i].name, '\0', PAK_NAME_LENGTH) != NULL) &&
+                ((entries[i].offset%PAK_ALIGNMENT) == 0) &&
+                (entries[i].offset <= pakFile.size) && (entries[i].size <= pakFile.size - entries[i].offset) &&
+                ((i == 0) || (strncmp(entries[i - 1].name, entries[i].name, PAK_NAME_LENGTH) < 0));
+    }
+
+    if (!valid)
+    {
+        TraceLog(LOG_WARNING, "PAK: [%s] Invalid or outdated archive", fileName);
+        UnmapFile(&pakFile);
+        return false;
+    }
+
+    pakEntries = entries;
+    pakCount = (int)header->count;
+
+    TraceLog(LOG_INFO, "PAK: [%s] %i entries %s (%u bytes)", fileName, pakCount, pakFile.mapped? "mapped" : "loaded", (unsigned int)pakFile.size);
+
+    return true;
+}
+
+void PakClose(void)
+{
+    UnmapFile(&pakFile);
+    pakEntries = NULL;
+    pakCount = 0;
+}
+
+// Binary search over the sorted index
+const unsigned char *PakGetData(const char *name, int *size)
+{
+    int low = 0;
+    int high = pakCount - 1;
+
+    while (low <= high)
+    {
+        int mid = (low + high)/2;
+        int order = strncmp(pakEntries[mid].name, name, PAK_NAME_LENGTH);
+
+        if (order == 0)
+        {
+            if (size != NULL) *size = (int)pakEntries[mid].size;
+            return pakFile.data + pakEntries[mid].offset;
+        }
+        else if (order < 0) low = mid + 1;
+        else high = mid - 1;
+    }
+
+    if (size != NULL) *size = 0;
+
+    return NULL;
+}
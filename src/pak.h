@@ -0,0 +1,61 @@
+/*******************************************************************************************
+*
+*   pak - Packed asset archive
+*
+*   All game assets in a single file, built by tools/asset_packer.c. The archive is memory
+*   mapped once and entries are returned as pointers into the mapping, ready to be passed to
+*   LoadImageFromMemory()/LoadWaveFromMemory() or used directly for pre-decoded formats.
+*
+*   ARCHIVE FORMAT (little-endian):
+*       PakHeader                           Magic, version and entry count
+*       PakEntry[count]                     Entries index, sorted by name
+*       Data                                File contents, each blob PAK_ALIGNMENT aligned
+*
+********************************************************************************************/
+
+#ifndef PAK_H
+#define PAK_H
+
+#include <stdbool.h>                        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define PAK_MAGIC                   "RPAK"
+#define PAK_VERSION                 1
+#define PAK_ALIGNMENT               16      // Blob alignment, keeps pre-decoded data SIMD aligned
+#define PAK_NAME_LENGTH             48      // Maximum entry name length, including terminator
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    char magic[4];                          // PAK_MAGIC
+    unsigned int version;                   // PAK_VERSION
+    unsigned int count;                     // Number of entries
+    unsigned int reserved;
+} PakHeader;
+
+typedef struct {
+    char name[PAK_NAME_LENGTH];             // File name, i.e. "atlas.png"
+    unsigned int offset;                    // Data offset from start of file
+    unsigned int size;                      // Data size in bytes
+    unsigned int reserved[2];
+} PakEntry;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool PakOpen(const char *fileName);                             // Map archive, returns false if missing or invalid
+void PakClose(void);                                            // Unmap archive, data returned by it becomes invalid
+const unsigned char *PakGetData(const char *name, int *size);   // Get entry data by file name, NULL if not packed
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // PAK_H
@@ -0,0 +1,127 @@
+/*******************************************************************************************
+*
+*   pcm_cache - Pre-decoded PCM sound cache
+*
+********************************************************************************************/
+
+#include "pcm_cache.h"
+#include "mapped_file.h"
+
+#include <string.h>                         // Required for: memcmp(), memchr(), strncmp()
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static MappedFile cacheFile = { 0 };       // Only used when the cache was opened from a file
+static const unsigned char *cacheData = NULL;
+static const PcmCacheEntry *cacheEntries = NULL;
+static unsigned int cacheCount = 0;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static bool SetCacheData(const unsigned char *data, size_t size);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+bool PcmCacheOpen(const char *fileName)
+{
+    PcmCacheClose();
+
+    cacheFile = MapFile(fileName);
+    if (cacheFile.data == NULL) return false;
+
+    if (!SetCacheData(cacheFile.data, cacheFile.size))
+    {
+        TraceLog(LOG_WARNING, "PCM CACHE: [%s] Invalid or outdated cache file", fileName);
+        UnmapFile(&cacheFile);
+        return false;
+    }
+
+    TraceLog(LOG_INFO, "PCM CACHE: [%s] %u sounds %s (%u bytes)", fileName, cacheCount, cacheFile.mapped? "mapped" : "loaded", (unsigned int)cacheFile.size);
+
+    return true;
+}
+
+bool PcmCacheOpenMemory(const unsigned char *data, int size)
+{
+    PcmCacheClose();
+
+    if ((data == NULL) || (size <= 0)) return false;
+
+    if (!SetCacheData(data, (size_t)size))
+    {
+        TraceLog(LOG_WARNING, "PCM CACHE: Invalid or outdated cache data");
+        return false;
+    }
+
+    TraceLog(LOG_INFO, "PCM CACHE: %u sounds from memory (%i bytes)", cacheCount, size);
+
+    return true;
+}
+
+void PcmCacheClose(void)
+{
+    UnmapFile(&cacheFile);
+    cacheData = NULL;
+    cacheEntries = NULL;
+    cacheCount = 0;
+}
+
+Wave PcmCacheGetWave(const char *name)
+{
+    Wave wave = { 0 };
+
+    for (unsigned int i = 0; i < cacheCount; i++)
+    {
+        if (strncmp(cacheEntries[i].name, name, PCM_CACHE_NAME_LENGTH) == 0)
+        {
+            wave.frameCount = cacheEntries[i].frameCount;
+            wave.sampleRate = cacheEntries[i].sampleRate;
+            wave.sampleSize = cacheEntries[i].sampleSize;
+            wave.channels = cacheEntries[i].channels;
+            wave.data = (void *)(cacheData + cacheEntries[i].offset);
+            break;
+        }
+    }
+
+    return wave;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Validate cache contents once so lookups can trust the data
+static bool SetCacheData(const unsigned char *data, size_t size)
+{
+    const PcmCacheHeader *header = (const PcmCacheHeader *)data;
+    bool valid = (size >= sizeof(PcmCacheHeader)) &&
+                 (memcmp(header->magic, PCM_CACHE_MAGIC, 4) == 0) &&
+                 (header->version == PCM_CACHE_VERSION) &&
+                 (header->count <= PCM_CACHE_MAX_ENTRIES) &&
+                 (size >= sizeof(PcmCacheHeader) + header->count*sizeof(PcmCacheEntry));
+
+    const PcmCacheEntry *entries = (const PcmCacheEntry *)(data + sizeof(PcmCacheHeader));
+
+    for (unsigned int i = 0; valid && (i < header->count); i++)
+    {
+        const PcmCacheEntry *entry = &entries[i];
+        size_t dataSize = (size_t)entry->frameCount*entry->channels*(entry->sampleSize/8);
+
+        valid = (memchr(entry->name, '\0', PCM_CACHE_NAME_LENGTH) != NULL) &&
+                ((entry->sampleSize == 16) || (entry->sampleSize == 32)) &&
+                ((entry->channels == 1) || (entry->channels == 2)) &&
+                ((entry->offset%PCM_CACHE_ALIGNMENT) == 0) &&
+                (entry->offset <= size) && (dataSize <= size - entry->offset);
+    }
+
+    if (valid)
+    {
+        cacheData = data;
+        cacheEntries = entries;
+        cacheCount = header->count;
+    }
+
+    return valid;
+}
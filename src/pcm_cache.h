@@ -0,0 +1,66 @@
+/*******************************************************************************************
+*
+*   pcm_cache - Pre-decoded PCM sound cache
+*
+*   Sounds are decoded once at bake time (see tools/sound_baker.c) and stored as raw PCM
+*   already converted to the audio device format. At runtime the container is memory mapped
+*   and every entry is returned as a Wave pointing straight into the mapping, no decoding,
+*   resampling or copies happen before the data reaches the audio system.
+*
+*   CONTAINER FORMAT (little-endian):
+*       PcmCacheHeader                      Magic, version and entry count
+*       PcmCacheEntry[count]                Name and format of every sound
+*       PCM data                            Interleaved samples, each blob PCM_CACHE_ALIGNMENT aligned
+*
+********************************************************************************************/
+
+#ifndef PCM_CACHE_H
+#define PCM_CACHE_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define PCM_CACHE_MAGIC             "SPCM"
+#define PCM_CACHE_VERSION           1
+#define PCM_CACHE_ALIGNMENT         16      // PCM blob alignment, allows aligned SIMD loads
+#define PCM_CACHE_NAME_LENGTH       32      // Maximum entry name length, including terminator
+#define PCM_CACHE_MAX_ENTRIES       64
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    char magic[4];                          // PCM_CACHE_MAGIC
+    unsigned int version;                   // PCM_CACHE_VERSION
+    unsigned int count;                     // Number of entries
+    unsigned int reserved;
+} PcmCacheHeader;
+
+typedef struct {
+    char name[PCM_CACHE_NAME_LENGTH];       // Source file name, i.e. "laser.mp3"
+    unsigned int offset;                    // PCM data offset from start of file
+    unsigned int frameCount;                // Total number of frames
+    unsigned int sampleRate;                // Frequency (samples per second)
+    unsigned short sampleSize;              // Bit depth (bits per sample): 16, 32 (float)
+    unsigned short channels;                // Number of channels (1-mono, 2-stereo)
+} PcmCacheEntry;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool PcmCacheOpen(const char *fileName);                // Map PCM cache file, returns false if missing or invalid
+bool PcmCacheOpenMemory(const unsigned char *data, int size);   // Use PCM cache from memory, data must outlive the cache
+void PcmCacheClose(void);                               // Unmap PCM cache, waves returned by it become invalid
+Wave PcmCacheGetWave(const char *name);                 // Get wave by source file name, data is NULL if not cached
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // PCM_CACHE_H
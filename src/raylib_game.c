@@ -19,10 +19,28 @@
 #endif
 
 #include <stdio.h>                          // Required for: printf()
-#include <stdlib.h>                         // Required for: 
-#include <string.h>                         // Required for:
+#include <stdlib.h>                         // Required for: atoi()
+#include <string.h>                         // Required for: strcmp()
 
 #include "raymath.h"
+#include "rlgl.h"                           // Required for: rlLoadRenderBatch(), rlDrawRenderBatchActive()
+
+#include "gameplay.h"                       // Game rules, simulation and world rendering, state is owned here
+#include "gameplay_module.h"                // Gameplay shared library hot reload (SUPPORT_GAMEPLAY_RELOAD)
+#include "sfx.h"                            // Sound effects voice pool
+#include "pcm_cache.h"                      // Pre-decoded sounds, baked by sound_baker
+#include "loader.h"                         // Background asset decoding
+#include "pak.h"                            // Packed assets archive, built by asset_packer
+#include "embedded.h"                       // Assets compiled into the executable (SUPPORT_EMBEDDED_RESOURCES)
+#include "startup_profiler.h"               // Startup timeline (SUPPORT_STARTUP_PROFILER)
+#include "thread.h"                         // Audio startup thread
+#include "hot_reload.h"                     // Development assets hot reload (SUPPORT_HOT_RELOAD)
+#include "snapshot.h"                       // Game state save and restore
+#include "rewind.h"                         // Recent game history, hold backspace to step back
+#include "flight_recorder.h"                // Last seconds of input and state, dumped on crash
+#include "net_session.h"                    // Loopback multiplayer, --host and --connect
+#include "net_peer.h"                       // Loopback two peers rollback play, --peer
+#include "net_spectator.h"                  // Loopback spectators with interest management, --spectate
 
 //----------------------------------------------------------------------------------
 // Defines and Macros
@@ -46,575 +64,523 @@ typedef enum {
     SCREEN_ENDING
 } GameScreen;
 
-// TODO: Define your custom data types here
-typedef struct {
-    Vector2 position;
-    Vector2 speed;
-    float rotation;
-    float acceleration;
-    int type;
-    bool active;
-
-}sEntity;
-
 typedef enum {
-    TYPE_ASTEROID_SMALL = 0,
-    TYPE_ASTEROID_MED,
-    TYPE_ASTEROID_LARGE,
-    TYPE_PLAYER,
-    TYPE_SHOT
-}EntityType;
-
-#define MAX_TEXTURES 4
-#define MAX_ASTEROIDS 40
-#define MAX_SHOTS 10
-#define MAX_SOUNDS 2
-#define SPAWN_ASTEROIDS 10
-#define MAX_LIVES 3
+    NETWORK_OFFLINE = 0,
+    NETWORK_HOST,                       // Runs the simulation, sends states to clients
+    NETWORK_CLIENT,                     // Draws states received from the host
+    NETWORK_PEER,                       // Runs the simulation with a remote peer, rollback on late inputs
+    NETWORK_SPECTATOR                   // Draws entities around a free camera, received from the host
+} NetworkMode;
 
-typedef enum {
-    TEXTURE_METEOR_SMALL = 0,
-    TEXTURE_METEOR_MED,
-    TEXTURE_METEOR_LARGE,
-    TEXTURE_PLAYER
-};
+// TODO: Define your custom data types here
 
-typedef enum {
-    SOUND_SHOOT =0,
-    SOUND_EXPLOSION
-};
+// Dynamic resolution, internal render target scale bounds and controller tuning
+#if !defined(RENDER_SCALE_MIN)
+    #define RENDER_SCALE_MIN 0.5f
+#endif
+#if !defined(RENDER_SCALE_MAX)
+    #define RENDER_SCALE_MAX 1.0f
+#endif
+#define RENDER_SCALE_STEP 0.125f
+#define RENDER_FRAME_BUDGET (1.0f/60.0f)    // Target frame time
+#define RENDER_SCALE_DOWN_FRAMES 15         // Consecutive frames over budget to scale down
+#define RENDER_SCALE_UP_FRAMES 120          // Consecutive frames with headroom to scale up, doubles after a failed upscale
+#define RENDER_SCALE_COOLDOWN 30            // Frames to wait after a change before measuring again
 
-Sound sounds[MAX_SOUNDS];
-Texture2D textures[MAX_TEXTURES];
+#define FLIGHT_RECORDER_FILE "crash.flight"     // Flight recorder dump, written on crash to the working directory
+
+// Dynamic resolution controller state
+// NOTE: rlgl does not expose GPU timer queries, frame time (includes waiting on the GPU through
+// buffer swap) is used to detect overload and measured CPU work time to detect headroom
+typedef struct {
+    float scale;                        // Current render target scale
+    float frameTime;                    // Smoothed frame time
+    float workTime;                     // Smoothed update + draw submission time
+    int overBudgetFrames;
+    int underBudgetFrames;
+    int upscaleFrames;                  // Frames with headroom required to scale up
+    int cooldown;
+    bool upscaled;                      // Last change was an upscale, dropping right after means it failed
+} RenderScaler;
 
 //----------------------------------------------------------------------------------
 // Global Variables Definition
 //----------------------------------------------------------------------------------
-static const int screenWidth = 800;
-static const int screenHeight = 450;
+static const int screenWidth = SCREEN_WIDTH;
+static const int screenHeight = SCREEN_HEIGHT;
 
 static RenderTexture2D target = { 0 };  // Render texture to render our game
+static GameScreen currentScreen = SCREEN_LOGO;  // Loading screen until every asset is ready
+static RenderScaler renderScaler = { RENDER_SCALE_MAX, RENDER_FRAME_BUDGET, 0.0f, 0, 0, RENDER_SCALE_UP_FRAMES, 0, false };
+static double frameWorkTime = 0.0;          // Last frame update + draw submission time
+
+// Textures decoded in background on startup, uploaded on the main thread by UpdateLoading()
+static const AssetRequest textureRequests[] = {
+    { ASSET_IMAGE, 0, "resources/atlas.png" },
+};
+
+// Sounds decoded and loaded by the audio startup thread, see AudioStartUp()
+static const AssetRequest soundRequests[] = {
+    { ASSET_WAVE, SOUND_SHOOT, "resources/laser.mp3" },
+    { ASSET_WAVE, SOUND_EXPLOSION, "resources/explode.wav" },
+};
+
+static Thread audioThread = { 0 };
+static unsigned int audioLoadedSounds = 0;  // Written by audio thread only
+static unsigned int audioReady = 0;         // Set by audio thread once device and sounds are ready
 
 // TODO: Define global variables here, recommended to make them static
-sEntity sPlayer = { 0 };
-sEntity sAsteroids[MAX_ASTEROIDS];
-sEntity sShots[MAX_SHOTS];
-sEntity sSuperBeam ={0};
-sEntity sLives[MAX_LIVES];
-int asteroidScore = 0;
-int currentAsteroids = MAX_ASTEROIDS;
-bool isGameOver = false;
-float beamCharge = 0.0f;
-float beamDelay = 1.f;
-bool preDetonation = true;
-int lives = 3;
-float spawnInvincibility =2.f;
-bool showDebug = false;
+static GameState game = { .spawnInvincibility = SIM(2.0f) };  // Invincible on first spawn, gameplay code keeps no state
+static const GameplayApi *gameplay = NULL;  // Gameplay entry points, linked in or from the gameplay library
+
+static unsigned char quickSave[SNAPSHOT_MAX_SIZE] = { 0 };  // Quick save slot, F5 save and F9 restore
+static int quickSaveSize = 0;
+static double quickSaveTime = 0.0;          // Last snapshot save and restore timings
+static double quickLoadTime = 0.0;
+
+static NetworkMode networkMode = NETWORK_OFFLINE;
+static unsigned short networkPort = NET_DEFAULT_PORT;
+static unsigned short remotePeerPort = NET_DEFAULT_PORT + 1;  // Peer mode, networkPort is the local one
+static Vector2 spectatorCenter = { WORLD_WIDTH/2.0f, WORLD_HEIGHT/2.0f };   // Spectator mode free camera
 
 //----------------------------------------------------------------------------------
 // Module Functions Declaration
 //----------------------------------------------------------------------------------
 static void UpdateDrawFrame(void);      // Update and Draw one frame
 void GameStartup(void);
-void GameUpdate(void);
-void GameRender(void);
 void GameShutdown(void);
-void GameReset(void);
-bool hasActiveAsteroids();
-void CheckAsteroidType(sEntity *entity);
-void PlayerDeath(void);
+static void DrawDebugInfo(void);
+static void UpdateQuickSave(void);
+static void ParseNetworkArgs(int argc, char *argv[]);
+static void StartNetwork(void);
+static void UpdateRenderScale(float frameTime, float workTime);
+static void SetRenderScale(float scale);
+static void OpenAssets(void);
+static void AudioStartUp(void *userData);
+static void UpdateLoading(void);
+static void UploadAtlas(Image image);
+#if defined(SUPPORT_HOT_RELOAD)
+static void StartHotReload(void);
+static void UpdateHotReload(void);
+#endif
+static float GetLoadingProgress(void);
+static void DrawLoading(void);
 
 
 void GameStartUp(void) {
 
-    InitAudioDevice();
-
-    //Using this to set/reset game to default
-    Image image1 = LoadImage("resources/player.png");
-    textures[TEXTURE_PLAYER] =LoadTextureFromImage(image1);
-    UnloadImage(image1);
-
-    Image image2 = LoadImage("resources/small-a.png");
-    textures[TEXTURE_METEOR_SMALL] =LoadTextureFromImage(image2);
-    UnloadImage(image2);
+    int zone = StartupZoneBegin("LoadRenderBatch");
+    game.worldBatch = rlLoadRenderBatch(1, WORLD_BATCH_ELEMENTS);
+    StartupZoneEnd(zone);
 
-    Image image3 = LoadImage("resources/med-b.png");
-    textures[TEXTURE_METEOR_MED] =LoadTextureFromImage(image3);
-    UnloadImage(image3);
-
-    Image image4 = LoadImage("resources/big-a.png");
-    textures[TEXTURE_METEOR_LARGE] =LoadTextureFromImage(image4);
-    UnloadImage(image4);
+#if defined(SUPPORT_GAMEPLAY_RELOAD)
+    gameplay = GameplayModuleLoad(GAMEPLAY_MODULE_PATH);
+    if (gameplay == NULL) TraceLog(LOG_FATAL, "GAMEPLAY: Gameplay library is required in this build");
+#else
+    gameplay = GetGameplayApi();
+#endif
 
-    sounds[SOUND_SHOOT] = LoadSound("resources/laser.mp3");
-    sounds[SOUND_EXPLOSION] = LoadSound("resources/explode.wav");
+    // NOTE: Textures are decoded off the main thread while the loading screen is shown,
+    // audio device and sounds are already coming up on the audio startup thread
+    LoaderStart(textureRequests, sizeof(textureRequests)/sizeof(textureRequests[0]));
 
+    //Using this to set/reset game to default
+    game.rngState = (unsigned int)GetRandomValue(1, 0x7fffffff);   // raylib generator is seeded from time on InitWindow()
+    game.viewScale = renderScaler.scale;
+    gameplay->GameReset(&game);
 
-    GameReset();
+    StartNetwork();
 }
 
+void GameShutdown(void) {
+    NetSpectatorStop();
+    NetSpectatorHostStop();
+    NetPeerStop();
+    NetClientStop();
+    NetHostStop();
+    FlightRecorderShutdown();
+    LoaderStop();                       // Window may be closed while still loading
+    ThreadJoin(&audioThread);
+#if defined(SUPPORT_HOT_RELOAD)
+    HotReloadStop();
+#endif
+#if defined(SUPPORT_GAMEPLAY_RELOAD)
+    GameplayModuleUnload();
+#endif
+    if (game.atlas.id > 0) UnloadTexture(game.atlas);
+    rlUnloadRenderBatch(game.worldBatch);
 
 
+    SfxShutdown();
+    PcmCacheClose();                    // Voices may reference cache memory until shutdown
+    PakClose();
+    CloseAudioDevice();
+}
 
-void GameUpdate(void) {
-if (!isGameOver) {
-    if (IsKeyDown(KEY_A)) {
-        sPlayer.rotation -= 200.f *GetFrameTime();
-    }
-
-    if (IsKeyDown(KEY_D)) {
-        sPlayer.rotation +=  200.f *GetFrameTime();
-    }
-
-    sPlayer.speed.x = cosf(sPlayer.rotation*DEG2RAD) * 100.f;
-    sPlayer.speed.y = sinf(sPlayer.rotation*DEG2RAD) * 100.f;
-
-    if (IsKeyDown(KEY_W)) {
-        if (sPlayer.acceleration <1.f) {
-            sPlayer.acceleration += 0.04f;
+// Draw debug overlay, toggled with F1 by gameplay code
+// NOTE: Kept in the host, frame timings and audio stats are not part of the game state
+static void DrawDebugInfo(void)
+{
+    BeginMode2D((Camera2D){ .zoom = renderScaler.scale });
+        DrawRectangle(5,5, 330, 235, Fade(SKYBLUE,.5f));
+        DrawRectangleLines(5,5,330,235,BLUE);
+
+
+        DrawText(TextFormat("- Player Rotation: (%06.1f)",SIM_TO_FLOAT(game.sPlayer.rotation)),15,45,10,YELLOW);
+        DrawText(TextFormat("- Player Position: (%06.1f,%06.1f)",SIM_TO_FLOAT(game.sPlayer.position.x),SIM_TO_FLOAT(game.sPlayer.position.y)),15,30,10,YELLOW);
+        DrawText(TextFormat("- Score: (%i)",game.asteroidScore),15,60,10,YELLOW);
+        DrawText(TextFormat("- Current Asteroids: (%i)",game.currentAsteroids),15,75,10,YELLOW);
+        DrawText(TextFormat("- World Batch: (%i draws, %i verts, %i submits)",game.worldBatchStats.drawCalls,game.worldBatchStats.vertices,game.worldBatchStats.submissions),15,90,10,YELLOW);
+        DrawText(TextFormat("- View Culling: (%i drawn, %i culled)",game.cullStats.drawn,game.cullStats.culled),15,105,10,YELLOW);
+        DrawText(TextFormat("- Chunks: (%i full, %i reduced, %i updated)",game.chunkStats.fullRate,game.chunkStats.reducedRate,game.chunkStats.asteroids),15,120,10,YELLOW);
+        DrawText(TextFormat("- Render Scale: (%.3f, %.1f ms frame, %.1f ms work)",renderScaler.scale,renderScaler.frameTime*1000.0f,renderScaler.workTime*1000.0f),15,135,10,YELLOW);
+        SfxStats sfxStats = SfxGetStats();
+        DrawText(TextFormat("- Voices: (%i/%i active, %i coalesced, %i stolen, %.2f ms mix)",sfxStats.activeVoices,sfxStats.voices,sfxStats.coalesced,sfxStats.stolen,sfxStats.mixTime),15,150,10,YELLOW);
+        DrawText(TextFormat("- Snapshot: (%i bytes, %.1f us save, %.1f us load)",quickSaveSize,quickSaveTime*1000000.0,quickLoadTime*1000000.0),15,165,10,YELLOW);
+        RewindStats rewindStats = RewindGetStats();
+        DrawText(TextFormat("- Rewind: (%.1f s, %i KB, %i KB as snapshots)",(float)rewindStats.frames/REWIND_TICK_RATE,rewindStats.memoryUsed/1024,rewindStats.snapshotBytes/1024),15,180,10,YELLOW);
+        DrawText(TextFormat("- State Hash: (%016llx, tick %u)",game.stateHash,game.simTick),15,195,10,YELLOW);
+        if (networkMode == NETWORK_HOST)
+        {
+            NetHostStats netStats = NetHostGetStats();
+            DrawText(TextFormat("- Host: (%i clients, %.0f B/tick, %.1f us encode, %i inputs queued)",netStats.clients,netStats.bytesPerTick,netStats.encodeTime*1000000.0f,netStats.pilotQueued),15,210,10,YELLOW);
+            NetSpectatorHostStats spectatorStats = NetSpectatorHostGetStats();
+            DrawText(TextFormat("- Spectators: (%i, %.1f KB/s, %.1f us encode, %.0f relevant, %.0f sent, %.0f deferred)",spectatorStats.spectators,spectatorStats.bytesPerSecond/1024.0f,spectatorStats.encodeTime*1000000.0f,spectatorStats.relevant,spectatorStats.sent,spectatorStats.deferred),15,225,10,YELLOW);
         }
-
-    }
-    sPlayer.position.x += (sPlayer.speed.x * sPlayer.acceleration) * GetFrameTime();
-    sPlayer.position.y += (sPlayer.speed.y * sPlayer.acceleration) * GetFrameTime();
-
-
-    // Player Wrapping around the screen.
-    if (sPlayer.position.x >screenWidth) {
-        sPlayer.position.x = sPlayer.position.x - screenWidth;
-    } else if (sPlayer.position.x <0) {
-        sPlayer.position.x = screenWidth;
-    }
-    if (sPlayer.position.y >screenHeight) {
-        sPlayer.position.y = sPlayer.position.y - screenHeight;
-    }else if (sPlayer.position.y <0) {
-        sPlayer.position.y = screenHeight;
-    }
-
-    //Spawn Shots
-    if (IsKeyPressed(KEY_SPACE)) {
-        for (int i = 0; i < MAX_SHOTS; i++) {
-            if (!sShots[i].active) {
-                sShots[i].active = true;
-                sShots[i].position = sPlayer.position;
-                sShots[i].rotation = sPlayer.rotation;
-                sShots[i].acceleration = 1.f;
-                sShots[i].speed.x = cosf(sPlayer.rotation*DEG2RAD) * 250.f;
-                sShots[i].speed.y = sinf(sPlayer.rotation*DEG2RAD) * 250.f;
-
-                PlaySound(sounds[SOUND_SHOOT]);
-
-                break;
-            }
+        else if (networkMode == NETWORK_CLIENT)
+        {
+            NetClientStats netStats = NetClientGetStats();
+            DrawText(TextFormat("- Client: (%s, %.0f B/tick, %i lost, %.1f delay, %i predicted)",netStats.pilot? "pilot" : netStats.connected? "viewer" : "waiting",netStats.bytesPerTick,netStats.lostStates,netStats.delay,netStats.predictedTicks),15,210,10,YELLOW);
         }
-    }
-    //
-    if (IsKeyPressed(KEY_B) && !sSuperBeam.active && beamCharge >= 100.f) {
-        sSuperBeam.active = true;
-        sSuperBeam.position = sPlayer.position;
-        sSuperBeam.rotation = sPlayer.rotation;
-        sSuperBeam.acceleration = 1.f;
-        sSuperBeam.speed.x = cosf(sPlayer.rotation*DEG2RAD) * 200.f;
-        sSuperBeam.speed.y = sinf(sPlayer.rotation*DEG2RAD) * 200.f;
-        beamCharge = 0.f;
-    }
+        else if (networkMode == NETWORK_PEER)
+        {
+            NetPeerStats netStats = NetPeerGetStats();
+            DrawText(TextFormat("- Peer: (%s, %i predicted, %i rollbacks, depth %i, %.2f ms worst, %i stalls, %i desyncs)",netStats.synchronized? "playing" : "waiting",netStats.rollback.predictedFrames,netStats.rollback.rollbacks,netStats.rollback.maxDepth,netStats.rollback.rollbackTime*1000.0f,netStats.stalls,netStats.desyncs),15,210,10,YELLOW);
+        }
+        else if (networkMode == NETWORK_SPECTATOR)
+        {
+            NetSpectatorStats netStats = NetSpectatorGetStats();
+            DrawText(TextFormat("- Spectator: (%s, %.1f KB/s, %i entities, view %.0f,%.0f)",netStats.connected? "watching" : "waiting",netStats.bytesPerSecond/1024.0f,netStats.entities,spectatorCenter.x,spectatorCenter.y),15,210,10,YELLOW);
+        }
+        else DrawText("- Network: (offline)",15,210,10,YELLOW);
+    EndMode2D();
+}
 
-    //Tracks delay to superbeam is active and changes to active
-    if (sSuperBeam.active && preDetonation) {
-        beamDelay -= GetFrameTime();
+// Quick save and restore of the game state, F5 saves, F9 restores last save
+static void UpdateQuickSave(void)
+{
+    if (IsKeyPressed(KEY_F5))
+    {
+        double start = GetTime();
+        quickSaveSize = SnapshotSave(&game, quickSave, sizeof(quickSave));
+        quickSaveTime = GetTime() - start;
     }
-    if (sSuperBeam.active && beamDelay < 0) {
-        preDetonation = false;
+    else if (IsKeyPressed(KEY_F9) && (quickSaveSize > 0))
+    {
+        double start = GetTime();
+        if (!SnapshotLoad(&game, quickSave, quickSaveSize)) TraceLog(LOG_WARNING, "SNAPSHOT: Quick save could not be restored");
+        quickLoadTime = GetTime() - start;
     }
+}
 
+// Network mode from command line: --host [port] runs the simulation for remote clients,
+// --connect [port] draws the game run by a host on this machine, --peer <localPort> <remotePort>
+// plays with another peer on this machine, --spectate [port] watches a host game with a free camera
+static void ParseNetworkArgs(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--peer") == 0) && ((i + 2) < argc))
+        {
+            networkMode = NETWORK_PEER;
+            networkPort = (unsigned short)atoi(argv[i + 1]);
+            remotePeerPort = (unsigned short)atoi(argv[i + 2]);
+            i += 2;
+            continue;
+        }
 
-    //Update SuperBeam
-
-    sSuperBeam.position.x += (sSuperBeam.speed.x * sSuperBeam.acceleration) * GetFrameTime();
-    sSuperBeam.position.y += (sSuperBeam.speed.y * sSuperBeam.acceleration) * GetFrameTime();
-
-
-
-
-    //Update asteroids
-    for (int i = 0; i < MAX_ASTEROIDS; i++) {
-        if (sAsteroids[i].active) {
-            sAsteroids[i].position.x += sAsteroids[i].speed.x * cosf(sAsteroids[i].rotation * DEG2RAD);
-            sAsteroids[i].position.y += sAsteroids[i].speed.y * sinf(sAsteroids[i].rotation * DEG2RAD);
-
-            if (sAsteroids[i].position.x > screenWidth) {
-                sAsteroids[i].position.x = sAsteroids[i].position.x -screenWidth;
-            } else if (sAsteroids[i].position.x <0) {
-                sAsteroids[i].position.x = screenWidth;
-            }
+        if (strcmp(argv[i], "--host") == 0) networkMode = NETWORK_HOST;
+        else if (strcmp(argv[i], "--connect") == 0) networkMode = NETWORK_CLIENT;
+        else if (strcmp(argv[i], "--spectate") == 0) networkMode = NETWORK_SPECTATOR;
+        else continue;
 
-            if (sAsteroids[i].position.y >screenHeight) {
-                sAsteroids[i].position.y = sAsteroids[i].position.y - screenHeight;
-            }else if (sAsteroids[i].position.y <0) {
-                sAsteroids[i].position.y = screenHeight;
-            }
+        if (((i + 1) < argc) && (atoi(argv[i + 1]) > 0))
+        {
+            networkPort = (unsigned short)atoi(argv[i + 1]);
+            i++;
         }
     }
+}
 
-    //update Shots
-    for (int i = 0; i < MAX_SHOTS; i++) {
-        if (sShots[i].active) {
-            sShots[i].position.x += (sShots[i].speed.x * sShots[i].acceleration) * GetFrameTime();
-            sShots[i].position.y += (sShots[i].speed.y * sShots[i].acceleration) * GetFrameTime();
-
-            if (sShots[i].position.x >screenWidth || sShots[i].position.x <0) {
-                sShots[i].active = false;
-            }
-
-            if (sShots[i].position.y >screenHeight || sShots[i].position.y <0) {
-                sShots[i].active = false;
-            }
+static void StartNetwork(void)
+{
+    bool started = true;
 
-        }
+    if (networkMode == NETWORK_HOST)
+    {
+        started = NetHostStart(networkPort);
+        if (started) NetSpectatorHostStart(networkPort + NET_SPECTATOR_PORT_OFFSET);   // Host plays on without spectators
     }
+    else if (networkMode == NETWORK_CLIENT) started = NetClientStart(networkPort);
+    else if (networkMode == NETWORK_PEER) started = NetPeerStart(networkPort, remotePeerPort, gameplay);
+    else if (networkMode == NETWORK_SPECTATOR) started = NetSpectatorStart(networkPort + NET_SPECTATOR_PORT_OFFSET);
 
-    //Update Live Counter.
-
-
-
-    //Collision between shots and asteroids
-    for (int i = 0; i < MAX_SHOTS; i++) {
-        if (sShots[i].active ) {
-            for (int j = 0; j < MAX_ASTEROIDS; j++) {
-                if (sAsteroids[j].active) {
-                    float texWidth = textures[sAsteroids[j].type].width;
-                    if (CheckCollisionCircles(sShots[i].position,2.f,sAsteroids[j].position,texWidth/2)){
-                        //Collision
-                        sAsteroids[j].active = false;
-                        sShots[i].active = false;
-                        asteroidScore++;
-                        currentAsteroids--;
-                        beamCharge += 10.f;
-                        CheckAsteroidType(&sAsteroids[j]);
-                        PlaySound(sounds[SOUND_EXPLOSION]);
-                        break;
-
-                    }
-                }
-            }
-        }
-    }
-    //Check Collison for Super Beam
-    if (sSuperBeam.active && !preDetonation) {
-        for (int i = 0; i < MAX_ASTEROIDS; i++) {
-            if (sAsteroids[i].active) {
-                float roidTexWidth = textures[sAsteroids[i].type].width;
-
-                if (CheckCollisionCircles(sSuperBeam.position,100.f,sAsteroids[i].position,roidTexWidth/2)) {
-                    sAsteroids[i].active = false;
-                    asteroidScore++;
-                    currentAsteroids--;
-                    PlaySound(sounds[SOUND_EXPLOSION]);
-
-                    break;
-                }
-            }
-        }
+    if (!started)
+    {
+        TraceLog(LOG_WARNING, "NET: Networking unavailable, playing offline");
+        networkMode = NETWORK_OFFLINE;
     }
+}
 
-    //Chcek for collision of player with asteroids if not just spawned in
-    if (spawnInvincibility <0) {
-
-        // Need to add a switch statement for pulling radius image size are all the same so they have the same hit box
-        for (int i = 0; i < MAX_ASTEROIDS; ++i) {
-
-            if (sAsteroids[i].active) {
-                float playerTexWidth = textures[sPlayer.type].width / 4; //Player divided by 4 because render texture is already divided by 4
-                float roidTexWidth = textures[sAsteroids[i].type].width;
-
-                switch (sAsteroids[i].type) {
-                    case TYPE_ASTEROID_SMALL:
-                        roidTexWidth = roidTexWidth/5;
-                    break;
-                    case TYPE_ASTEROID_MED:
-                        roidTexWidth = roidTexWidth/4;
-                    case TYPE_ASTEROID_LARGE:
-                        roidTexWidth = roidTexWidth/3;
-
-                    break;
-                    default: ;
-                }
+// Adjust render target scale from last frame timings, with hysteresis: scale down quickly
+// when over budget, scale up only after a long run with headroom
+static void UpdateRenderScale(float frameTime, float workTime)
+{
+    RenderScaler *scaler = &renderScaler;
 
-                if (CheckCollisionCircles(sPlayer.position,playerTexWidth,sAsteroids[i].position,roidTexWidth)) {
-                    PlayerDeath();
-                }
-            }
-        }
-    }
+    if (frameTime <= 0.0f) return;          // First frame, no timings yet
 
-    if (beamCharge <= 100.f) {
-        beamCharge += GetFrameTime();
-    }
+    scaler->frameTime += (frameTime - scaler->frameTime)*0.1f;
+    scaler->workTime += (workTime - scaler->workTime)*0.1f;
 
-    if (spawnInvincibility> 0) {
-        spawnInvincibility -= GetFrameTime();
+    if (scaler->cooldown > 0) {
+        scaler->cooldown--;
+        return;
     }
-    if (hasActiveAsteroids() == false) {
-        isGameOver = true;
-    }
-}
 
-    if (isGameOver && IsKeyPressed(KEY_R)) {
-        GameReset();
-        isGameOver = false;
-    }
+    if (scaler->frameTime > RENDER_FRAME_BUDGET*1.1f) scaler->overBudgetFrames++;
+    else scaler->overBudgetFrames = 0;
 
+    if ((scaler->frameTime < RENDER_FRAME_BUDGET*1.02f) && (scaler->workTime < RENDER_FRAME_BUDGET*0.7f)) scaler->underBudgetFrames++;
+    else scaler->underBudgetFrames = 0;
 
-}
-void GameRender(void) {
-    //draw the player
-    if (spawnInvincibility>0) {
-        DrawTexturePro(textures[TEXTURE_PLAYER],
-                (Rectangle) { 0, 0, textures[TEXTURE_PLAYER].width, textures[TEXTURE_PLAYER].height },
-                (Rectangle) { sPlayer.position.x, sPlayer.position.y, textures[TEXTURE_PLAYER].width/2, textures[TEXTURE_PLAYER].height/2 },
-                (Vector2) {textures[TEXTURE_PLAYER].width/4,textures[TEXTURE_PLAYER].height/4},
-                sPlayer.rotation +90,
-                GRAY);
-
-    }else {
-
-        DrawTexturePro(textures[TEXTURE_PLAYER],
-        (Rectangle) { 0, 0, textures[TEXTURE_PLAYER].width, textures[TEXTURE_PLAYER].height },
-        (Rectangle) { sPlayer.position.x, sPlayer.position.y, textures[TEXTURE_PLAYER].width/2, textures[TEXTURE_PLAYER].height/2 },
-        (Vector2) {textures[TEXTURE_PLAYER].width/4,textures[TEXTURE_PLAYER].height/4},
-        sPlayer.rotation +90,
-        RAYWHITE);
+    if ((scaler->overBudgetFrames >= RENDER_SCALE_DOWN_FRAMES) && (scaler->scale > RENDER_SCALE_MIN)) {
+        // Back off further before trying again if the last upscale did not hold
+        if (scaler->upscaled && (scaler->upscaleFrames < RENDER_SCALE_UP_FRAMES*8)) scaler->upscaleFrames *= 2;
 
+        SetRenderScale(scaler->scale - RENDER_SCALE_STEP);
+        scaler->upscaled = false;
+    } else if ((scaler->underBudgetFrames >= scaler->upscaleFrames) && (scaler->scale < RENDER_SCALE_MAX)) {
+        SetRenderScale(scaler->scale + RENDER_SCALE_STEP);
+        scaler->upscaled = true;
+    } else if (scaler->underBudgetFrames >= RENDER_SCALE_UP_FRAMES*8) {
+        scaler->upscaled = false;           // Stable for long enough, forget previous failures
+        scaler->upscaleFrames = RENDER_SCALE_UP_FRAMES;
     }
+}
 
+// Recreate render target at the given scale of the screen size
+static void SetRenderScale(float scale)
+{
+    if (scale < RENDER_SCALE_MIN) scale = RENDER_SCALE_MIN;
+    if (scale > RENDER_SCALE_MAX) scale = RENDER_SCALE_MAX;
 
+    renderScaler.scale = scale;
+    renderScaler.overBudgetFrames = 0;
+    renderScaler.underBudgetFrames = 0;
+    renderScaler.cooldown = RENDER_SCALE_COOLDOWN;
 
-    //draw basic UI
-
-    if (showDebug) {
-        DrawRectangle(5,5, 250, 100, Fade(SKYBLUE,.5f));
-        DrawRectangleLines(5,5,250,100,BLUE);
+    UnloadRenderTexture(target);
+    target = LoadRenderTexture((int)(screenWidth*scale), (int)(screenHeight*scale));
+    SetTextureFilter(target.texture, TEXTURE_FILTER_BILINEAR);
 
+    LOG("INFO: Render scale set to %.3f (%ix%i)\n", scale, target.texture.width, target.texture.height);
+}
 
-        DrawText(TextFormat("- Player Rotation: (%06.1f)",sPlayer.rotation),15,45,10,YELLOW);
-        DrawText(TextFormat("- Player Position: (%06.1f,%06.1f)",sPlayer.position.x,sPlayer.position.y),15,30,10,YELLOW);
-        DrawText(TextFormat("- Score: (%i)",asteroidScore),15,60,10,YELLOW);
-        DrawText(TextFormat("- Current Asteroids: (%i)",currentAsteroids),15,75,10,YELLOW);
-        //DrawText(TextFormat("- Beam Charge : (%f)",),15,100,10,YELLOW);
-    }
+// Open packed archive and PCM cache, must be done before any asset is decoded
+static void OpenAssets(void)
+{
+    int zone = StartupZoneBegin("OpenAssets");
+
+    // Assets come from a single mapped archive when it was built, loose files are used otherwise
+    // Sounds come pre-decoded from the PCM cache when it was baked, source files are decoded otherwise
+    int pcmCacheSize = 0;
+#if defined(SUPPORT_EMBEDDED_RESOURCES)
+    // Assets resolve from memory, no file is opened unless an asset was not embedded
+    const unsigned char *pcmCache = GetEmbeddedData("sounds.pcm", &pcmCacheSize);
+    PcmCacheOpenMemory(pcmCache, pcmCacheSize);
+#else
+    const unsigned char *pcmCache = PakOpen("resources/assets.pak")? PakGetData("sounds.pcm", &pcmCacheSize) : NULL;
 
+    if (!PcmCacheOpenMemory(pcmCache, pcmCacheSize)) PcmCacheOpen("resources/sounds.pcm");
+#endif
 
+    StartupZoneEnd(zone);
+}
 
+// Init audio device and load sounds, runs on a worker thread in parallel with window creation
+// NOTE: Nothing else touches the audio device or the sfx pool until this thread is joined
+static void AudioStartUp(void *userData)
+{
+    (void)userData;
 
+    int zone = StartupZoneBegin("InitAudioDevice");
+    InitAudioDevice();
+    StartupZoneEnd(zone);
 
-    //draw asteroids
+    SfxInit();
 
-    for (int i = 0; i < MAX_ASTEROIDS; i++) {
-        if (sAsteroids[i].active) {
-            DrawTexturePro(textures[sAsteroids[i].type],
-                (Rectangle){0, 0,textures[sAsteroids[i].type].width,textures[sAsteroids[i].type].height},
-                (Rectangle){sAsteroids[i].position.x,sAsteroids[i].position.y,textures[sAsteroids[i].type].width,textures[sAsteroids[i].type].height },
-                (Vector2){textures[sAsteroids[i].type].width/2,textures[sAsteroids[i].type].height/2},
-                sAsteroids[i].rotation,
-                RAYWHITE);
-        }
-    }
+    for (int i = 0; i < (int)(sizeof(soundRequests)/sizeof(soundRequests[0])); i++)
+    {
+        LoadedAsset asset = LoaderDecodeAsset(&soundRequests[i]);
 
-    //draw shots
-    for (int i = 0; i < MAX_SHOTS; i++) {
-        if (sShots[i].active) {
-            DrawCircle(sShots[i].position.x, sShots[i].position.y, 2.f, RAYWHITE);
-        }
-    }
-    //Draw Lives UI
-
-    for (int i = 0; i < MAX_LIVES; i++) {
-        if (sLives[i].active) {
-            DrawTexturePro(textures[TEXTURE_PLAYER],
-        (Rectangle) { 0, 0, textures[TEXTURE_PLAYER].width, textures[TEXTURE_PLAYER].height },
-        (Rectangle) { sLives[i].position.x,sLives[i].position.y, textures[TEXTURE_PLAYER].width/2, textures[TEXTURE_PLAYER].height/2 },
-        (Vector2) {textures[TEXTURE_PLAYER].width/4,textures[TEXTURE_PLAYER].height/4},
-        sLives[i].rotation,
-        RAYWHITE);
+        if (asset.shared) SfxLoadWaveShared(asset.id, asset.wave);
+        else
+        {
+            SfxLoadWave(asset.id, asset.wave);
+            UnloadWave(asset.wave);
         }
-    }
 
-    //Draws Pre active super beam
-    if (sSuperBeam.active && preDetonation) {
-        DrawCircle(sSuperBeam.position.x, sSuperBeam.position.y,10.f, RAYWHITE);
+        ATOMIC_STORE(&audioLoadedSounds, i + 1);
     }
 
-    //Draws active  Beam
-    if (sSuperBeam.active && !preDetonation) {
-        DrawCircle(sSuperBeam.position.x, sSuperBeam.position.y, 100.f, RAYWHITE);
-        //DrawRectanglePro((Rectangle){sPlayer.position.x, sPlayer.position.y,250,400},(Vector2){250/2,0},sPlayer.rotation-90,RAYWHITE);
-    }
+    ATOMIC_STORE(&audioReady, 1);
+}
 
-    //Draw BeamCharge Bar
-    float beamChargeNorm = Normalize(beamCharge,0.f,100.f);
-    if (beamChargeNorm < 1.f) {
-        DrawRectangle(400,20,100*beamChargeNorm,30, YELLOW);
-    } else {
-        DrawRectangle(400,20,100,30, GREEN); // when fully charged turn green.
-    }
+// Upload textures decoded by the loader thread, GPU resources are created here
+static void UpdateLoading(void)
+{
+    LoadedAsset asset = { 0 };
 
-    DrawRectangleLines(400,20,100,30, WHITE);
+    while (LoaderPoll(&asset))
+    {
+        int zone = StartupZoneBegin(asset.fileName);
 
-    if (isGameOver) {
-        DrawText(TextFormat("Game Over"),screenWidth/2-50,screenHeight/2 ,30,YELLOW);
-        DrawText(TextFormat("Press R to Restart"),screenWidth/2 - 50,screenHeight/2 + 30 ,20,YELLOW);
+        if (asset.type == ASSET_IMAGE)
+        {
+            UploadAtlas(asset.image);
+            UnloadImage(asset.image);
+        }
 
-    }
-}
-void GameShutdown(void) {
-    for (int i = 0; i < MAX_TEXTURES; i++) {
-        UnloadTexture(textures[i]);
+        StartupZoneEnd(zone);
     }
 
+    // Audio startup thread is joined before gameplay, sfx pool is only used from the main thread after it
+    if (LoaderIsDone() && ATOMIC_LOAD(&audioReady))
+    {
+        ThreadJoin(&audioThread);
+        currentScreen = SCREEN_GAMEPLAY;
 
-    for (int i = 0; i < MAX_SOUNDS; i++) {
-        UnloadSound(sounds[i]);
+#if defined(SUPPORT_HOT_RELOAD)
+        StartHotReload();
+#endif
     }
-    CloseAudioDevice();
 }
-void GameReset(void) {
-    sPlayer.position = (Vector2) { screenWidth/2, screenHeight/2};
-    sPlayer.speed = (Vector2) { 0, 0};
-    sPlayer.rotation = 0;
-    sPlayer.acceleration = 0;
-    sPlayer.type = TYPE_PLAYER;
-    asteroidScore = 0;
-    currentAsteroids = MAX_ASTEROIDS;
-    beamDelay = 1.f;
-    preDetonation = true;
-    lives = MAX_LIVES;
-    beamCharge = 0.f;
-
-    float livesUIX = 30;
-
-    for (int i = 0; i < lives; i++) {
-        sLives[i].active = true;
-        sLives[i].position.x = livesUIX;
-        sLives[i].position.y = 50;
-        livesUIX+= 40;
-        sLives[i].type = TYPE_PLAYER;
-
-    }
 
+// Upload atlas texture, replacing the current one
+// NOTE: Single upload for all sprites, shapes are also drawn from the atlas white block
+// so sprites, shots and bars are batched together without texture switches
+static void UploadAtlas(Image image)
+{
+    Texture2D texture = LoadTextureFromImage(image);
+    if (texture.id == 0) return;
 
-    for (int i = 0; i < SPAWN_ASTEROIDS; i++) {
-        sAsteroids[i].rotation = (float)GetRandomValue(0, 360);
-        sAsteroids[i].position = (Vector2) {GetRandomValue(0,screenWidth), GetRandomValue(0,screenHeight)};
-        sAsteroids[i].type = GetRandomValue(TYPE_ASTEROID_SMALL,TYPE_ASTEROID_LARGE);
-        sAsteroids[i].speed = (Vector2) { (float)GetRandomValue(1,2),(float)GetRandomValue(1,2)};
-        sAsteroids[i].active = true;
-    }
+    if (game.atlas.id > 0) UnloadTexture(game.atlas);
+    game.atlas = texture;
 
-    for (int i = 0; i < MAX_SHOTS; i++) {
-        sShots[i].active = false;
-    }
+    SetShapesTexture(game.atlas, (Rectangle){ atlasRects[ATLAS_SPRITE_WHITE].x + 1, atlasRects[ATLAS_SPRITE_WHITE].y + 1,
+        atlasRects[ATLAS_SPRITE_WHITE].width - 2, atlasRects[ATLAS_SPRITE_WHITE].height - 2 });
+}
 
-    sSuperBeam.active = false;
+#if defined(SUPPORT_HOT_RELOAD)
+// Watch every startup asset for changes, once loading is done and the sfx pool is owned by the main thread
+static void StartHotReload(void)
+{
+    AssetRequest requests[HOT_RELOAD_MAX_ASSETS] = { 0 };
+    int textureCount = (int)(sizeof(textureRequests)/sizeof(textureRequests[0]));
+    int soundCount = (int)(sizeof(soundRequests)/sizeof(soundRequests[0]));
 
-}
+    for (int i = 0; i < textureCount; i++) requests[i] = textureRequests[i];
+    for (int i = 0; i < soundCount; i++) requests[textureCount + i] = soundRequests[i];
 
-bool hasActiveAsteroids() {
-    for (int    i = 0;    i < MAX_ASTEROIDS; i++) {
-        if (sAsteroids[i].active) {
-            return true;
-        }
-    }
-    return false;
+    HotReloadStart("resources", requests, textureCount + soundCount);
 }
 
-void CheckAsteroidType(sEntity *entity)
- {
-    //take asteroid check type and spawn new small asteroid if passed asteroid is bigge than small
-    // spawn asteroids from the player in random directions .
-;
-        // check type of collision
-    if (entity->type == TYPE_ASTEROID_MED ) {
-        int asteroidsSpawned = 0;
-        //Seach for non active asteroid and spawn on entity death
-        for (int i = 0; i < MAX_ASTEROIDS; i++) {
-            if (!sAsteroids[i].active) {
-                sAsteroids[i].rotation = (float)GetRandomValue(0, 360);
-                sAsteroids[i].position = entity->position;
-                sAsteroids[i].type = TYPE_ASTEROID_SMALL;
-                sAsteroids[i].speed = (Vector2) { (float)GetRandomValue(1,2),(float)GetRandomValue(1,2)};
-                sAsteroids[i].active = true;
-
-                asteroidsSpawned++;
-                //Check if enough child Asteroids have spawned
-                if (asteroidsSpawned == 1 ) {
-                    break;
-                }
-            }
-        }
+// Swap reloaded assets, called at a frame boundary so nothing drawn or queued this frame uses the old ones
+// NOTE: Sprite rectangles are compiled in (atlas_data.h), a re-packed atlas with a different layout
+// needs a rebuild, only pixel changes are picked up
+static void UpdateHotReload(void)
+{
+    LoadedAsset asset = { 0 };
 
-    }
+    while (HotReloadPoll(&asset))
+    {
+        if (asset.type == ASSET_IMAGE)
+        {
+            if ((asset.image.width != ATLAS_WIDTH) || (asset.image.height != ATLAS_HEIGHT)) TraceLog(LOG_WARNING, "HOT RELOAD: [%s] Atlas size changed, rebuild to update sprite rectangles", asset.fileName);
+            else UploadAtlas(asset.image);
 
-    if (entity->type == TYPE_ASTEROID_LARGE ) {
-        int asteroidsSpawned = 0;
-        for (int i = 0; i < MAX_ASTEROIDS; i++) {
-            if (!sAsteroids[i].active) {
-                sAsteroids[i].rotation = (float)GetRandomValue(0, 360);
-                sAsteroids[i].position = entity->position;
-                sAsteroids[i].type = TYPE_ASTEROID_SMALL;
-                sAsteroids[i].speed = (Vector2) { (float)GetRandomValue(1,2),(float)GetRandomValue(1,2)};
-                sAsteroids[i].active = true;
-
-                asteroidsSpawned++;
-
-                if (asteroidsSpawned == 2 ) {
-                    break;
-                }
-            }
+            UnloadImage(asset.image);
+        }
+        else
+        {
+            SfxReloadWave(asset.id, asset.wave);
+            UnloadWave(asset.wave);
         }
-
     }
 }
+#endif
 
-void PlayerDeath(void) {
-    lives--;
-    sLives[lives].active = false;
-
-    if (lives <= 0) {
-        isGameOver = true;
-
-    } else {
-        sPlayer.position = (Vector2) { screenWidth/2, screenHeight/2};
-        sPlayer.speed = (Vector2) { 0, 0};
-        sPlayer.rotation = 0;
-        sPlayer.acceleration = 0;
-        sPlayer.type = TYPE_PLAYER;
-        spawnInvincibility = 2.f;
-    }
-
+// Get loading progress of textures and sounds together
+static float GetLoadingProgress(void)
+{
+    float textureCount = (float)(sizeof(textureRequests)/sizeof(textureRequests[0]));
+    float soundCount = (float)(sizeof(soundRequests)/sizeof(soundRequests[0]));
 
+    return (LoaderGetProgress()*textureCount + (float)ATOMIC_LOAD(&audioLoadedSounds))/(textureCount + soundCount);
+}
 
+// Draw loading screen with assets progress
+static void DrawLoading(void)
+{
+    const int barWidth = 300;
+    const int barHeight = 12;
+    int barX = screenWidth/2 - barWidth/2;
+    int barY = screenHeight/2 + 20;
+
+    BeginMode2D((Camera2D){ .zoom = renderScaler.scale });
+        DrawText("ASTEROIDS RL", screenWidth/2 - MeasureText("ASTEROIDS RL", 40)/2, screenHeight/2 - 40, 40, RAYWHITE);
+        DrawRectangleLines(barX, barY, barWidth, barHeight, RAYWHITE);
+        DrawRectangle(barX + 2, barY + 2, (int)((barWidth - 4)*GetLoadingProgress()), barHeight - 4, RAYWHITE);
+    EndMode2D();
 }
 
 //------------------------------------------------------------------------------------
 // Program main entry point
 //------------------------------------------------------------------------------------
-int main(void)
+int main(int argc, char *argv[])
 {
-#if !defined(_DEBUG)
-    SetTraceLogLevel(LOG_NONE);         // Disable raylib trace log messages
+#if !defined(_DEBUG) && !defined(SUPPORT_STARTUP_PROFILER)
+    SetTraceLogLevel(LOG_NONE);         // Disable raylib trace log messages, kept when profiling startup
 #endif
 
     // Initialization
     //--------------------------------------------------------------------------------------
-    InitWindow(screenWidth, screenHeight, "Asteroids RL");
+    // Audio device init and sound decoding run on a worker thread while the window is created,
+    // the thread is joined before gameplay starts (see UpdateLoading())
+    ParseNetworkArgs(argc, argv);
+    FlightRecorderInit(FLIGHT_RECORDER_FILE);
+    OpenAssets();
+    if (!ThreadStart(&audioThread, AudioStartUp, NULL)) AudioStartUp(NULL);
+
+    int zone = StartupZoneBegin("InitWindow");
+    InitWindow(screenWidth, screenHeight, (networkMode == NETWORK_HOST)? "Asteroids RL - Host" :
+        (networkMode == NETWORK_CLIENT)? "Asteroids RL - Client" :
+        (networkMode == NETWORK_PEER)? "Asteroids RL - Peer" :
+        (networkMode == NETWORK_SPECTATOR)? "Asteroids RL - Spectator" : "Asteroids RL");
+    StartupZoneEnd(zone);
 
     
     // TODO: Load resources / Initialize variables at this point
+    zone = StartupZoneBegin("GameStartUp");
     GameStartUp();
+    StartupZoneEnd(zone);
     // Render texture to draw full screen, enables screen scaling
     // NOTE: If screen is scaled, mouse input should be scaled proportionally
-    target = LoadRenderTexture(screenWidth, screenHeight);
+    zone = StartupZoneBegin("LoadRenderTexture");
+    target = LoadRenderTexture((int)(screenWidth*renderScaler.scale), (int)(screenHeight*renderScaler.scale));
     SetTextureFilter(target.texture, TEXTURE_FILTER_BILINEAR);
+    StartupZoneEnd(zone);
 
 #if defined(PLATFORM_WEB)
     emscripten_set_main_loop(UpdateDrawFrame, 60, 1);
@@ -652,8 +618,71 @@ void UpdateDrawFrame(void)
     //----------------------------------------------------------------------------------
     // TODO: Update variables / Implement example logic at this point
     //----------------------------------------------------------------------------------
+    UpdateRenderScale(GetFrameTime(), (float)frameWorkTime);
+    double frameStart = GetTime();
+
+    if (currentScreen == SCREEN_LOGO) UpdateLoading();
+    else
+    {
+#if defined(SUPPORT_HOT_RELOAD)
+        UpdateHotReload();                  // Swap changed assets before this frame uses them
+#endif
+#if defined(SUPPORT_GAMEPLAY_RELOAD)
+        gameplay = GameplayModuleReload();  // Swap gameplay code between ticks, state is kept in game
+#endif
+        game.viewSize = (Vector2){ (float)target.texture.width, (float)target.texture.height };
+        game.viewScale = renderScaler.scale;
+
+        unsigned int input = gameplay->GameReadInput();
+
+        if (networkMode == NETWORK_CLIENT)
+        {
+            // Game state comes from the host, ship is predicted from input, debug overlay is local
+            if (input & GAME_INPUT_DEBUG) game.showDebug = !game.showDebug;
+            NetClientUpdate(&game, gameplay, input, GetFrameTime());
+        }
+        else if (networkMode == NETWORK_PEER)
+        {
+            // No quick save, rewind or flight recorder, both peers must step the same ticks
+            if (input & GAME_INPUT_DEBUG) game.showDebug = !game.showDebug;
+            if (!NetPeerUpdate(&game, input)) networkMode = NETWORK_OFFLINE;    // Peer left, game goes on locally
+        }
+        else if (networkMode == NETWORK_SPECTATOR)
+        {
+            // Arrow keys fly the camera over the wrapped world, nothing is simulated here
+            if (input & GAME_INPUT_DEBUG) game.showDebug = !game.showDebug;
+
+            Vector2 direction = { (float)(IsKeyDown(KEY_RIGHT) - IsKeyDown(KEY_LEFT)), (float)(IsKeyDown(KEY_DOWN) - IsKeyDown(KEY_UP)) };
+            spectatorCenter = Vector2Add(spectatorCenter, Vector2Scale(direction, 600.0f*GetFrameTime()));
+            spectatorCenter.x = Wrap(spectatorCenter.x, 0.0f, (float)WORLD_WIDTH);
+            spectatorCenter.y = Wrap(spectatorCenter.y, 0.0f, (float)WORLD_HEIGHT);
+
+            NetSpectatorUpdate(&game, spectatorCenter);
+        }
+        else
+        {
+            UpdateQuickSave();
+
+            // Step back one tick per frame while held, game resumes from there on release
+            if (IsKeyDown(KEY_BACKSPACE)) RewindSeek(&game, game.simTick - 1);
+            else
+            {
+                if (networkMode == NETWORK_HOST) input = NetHostGetInput(input);   // Remote pilot input
+
+                gameplay->GameStep(&game, input);
+                RewindRecord(&game);
+                FlightRecorderTick(&game, input, GetFrameTime());
+            }
+
+            if (networkMode == NETWORK_HOST)
+            {
+                NetHostUpdate(&game);
+                NetSpectatorHostUpdate(&game);
+            }
+        }
 
-        GameUpdate();
+        SfxUpdate();                        // Dispatch this tick sound triggers
+    }
 
 
     // Draw
@@ -665,7 +694,12 @@ void UpdateDrawFrame(void)
         
         // TODO: Draw your game screen here
 
-        GameRender();
+        if (currentScreen == SCREEN_LOGO) DrawLoading();
+        else
+        {
+            gameplay->GameRender(&game);
+            if (game.showDebug) DrawDebugInfo();
+        }
         //DrawText("Welcome to raylib NEXT gamejam!", 150, 140, 30, BLACK);
        // DrawRectangleLinesEx((Rectangle){ 0, 0, screenWidth, screenHeight }, 16, BLACK);
         
@@ -675,11 +709,26 @@ void UpdateDrawFrame(void)
     BeginDrawing();
         ClearBackground(RAYWHITE);
         
-        // Draw render texture to screen, scaled if required
-        DrawTexturePro(target.texture, (Rectangle){ 0, 0, (float)target.texture.width, -(float)target.texture.height }, (Rectangle){ 0, 0, (float)target.texture.width, (float)target.texture.height }, (Vector2){ 0, 0 }, 0.0f, WHITE);
+        // Draw render texture to screen, upscaled with bilinear filter if rendered at lower resolution
+        DrawTexturePro(target.texture, (Rectangle){ 0, 0, (float)target.texture.width, -(float)target.texture.height }, (Rectangle){ 0, 0, (float)screenWidth, (float)screenHeight }, (Vector2){ 0, 0 }, 0.0f, WHITE);
 
         // TODO: Draw everything that requires to be drawn at this point, maybe UI?
 
+        rlDrawRenderBatchActive();          // Submit before measuring, EndDrawing() also waits for next frame
+        frameWorkTime = GetTime() - frameStart;
     EndDrawing();
+
+#if defined(SUPPORT_STARTUP_PROFILER)
+    // Startup ends once the first gameplay frame has been presented
+    static int presentedFrames = 0;
+    if (presentedFrames == 0) StartupMark("First frame presented");
+    if ((currentScreen == SCREEN_GAMEPLAY) && (presentedFrames >= 0))
+    {
+        StartupMark("First gameplay frame presented");
+        StartupReport("startup_profile.json");
+        presentedFrames = -1;
+    }
+    else if (presentedFrames >= 0) presentedFrames++;
+#endif
     //----------------------------------------------------------------------------------  
 }
\ No newline at end of file
@@ -0,0 +1,286 @@
+/*******************************************************************************************
+*
+*   rewind - Recent game history, step back to any recorded tick and resume from there
+*
+*   NOTE: Encoded frames are stored back to back in the memory block, a frame that does not
+*   fit at the end wraps to the start, live frames always span from the oldest frame offset
+*   to the write position
+*
+*   ENCODING: Sequence of tokens [zeros][literals][literal bytes...], zeros and literals are
+*   single byte counts, zeros skips unchanged bytes and literal bytes are XORed into the
+*   reference snapshot. Reference bytes past its size read as zero.
+*
+********************************************************************************************/
+
+#include "rewind.h"
+#include "snapshot.h"                       // Required for: SnapshotSave(), SnapshotLoad()
+
+#include <string.h>                         // Required for: memcpy(), memset(), memcmp()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+// Worst case encoded frame, token overhead when no byte repeats the reference
+#define REWIND_ENCODED_MAX_SIZE     (SNAPSHOT_MAX_SIZE + 2*(SNAPSHOT_MAX_SIZE/255 + 2))
+
+typedef char RewindMemoryCheck[(REWIND_MEMORY >= REWIND_ENCODED_MAX_SIZE)? 1 : -1];
+typedef char RewindKeyframeCheck[(REWIND_KEYFRAME_INTERVAL < REWIND_MAX_FRAMES)? 1 : -1];
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    unsigned int tick;
+    int offset;                             // Encoded data position in memory block
+    int encodedSize;
+    int size;                               // Snapshot size
+    bool keyframe;                          // Encoded against zeros instead of previous frame
+} RewindFrame;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static unsigned char memory[REWIND_MEMORY] = { 0 };
+static RewindFrame frames[REWIND_MAX_FRAMES] = { 0 };
+static int firstFrame = 0;
+static int frameCount = 0;
+static int writePosition = 0;
+static int sinceKeyframe = 0;               // Frames in the chain up to the reference
+static RewindStats stats = { 0 };
+
+static unsigned char lastSnapshot[SNAPSHOT_MAX_SIZE] = { 0 };   // Reference for the next frame: newest one or last seek
+static int lastSize = 0;
+static unsigned int referenceTick = 0;      // Tick of lastSnapshot
+static unsigned char snapshot[SNAPSHOT_MAX_SIZE] = { 0 };       // Scratch buffers
+static unsigned char encoded[REWIND_ENCODED_MAX_SIZE] = { 0 };
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static RewindFrame *GetFrame(int index);
+static void DropOldestChain(void);
+static void DropNewerFrames(int count);
+static int ReserveMemory(int size);
+static unsigned char GetDeltaByte(const unsigned char *data, const unsigned char *reference, int referenceSize, int i);
+static int EncodeDelta(const unsigned char *data, int size, const unsigned char *reference, int referenceSize, unsigned char *output);
+static bool DecodeDelta(const unsigned char *input, int inputSize, unsigned char *data, int size);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+void RewindReset(void)
+{
+    firstFrame = 0;
+    frameCount = 0;
+    writePosition = 0;
+    sinceKeyframe = 0;
+    lastSize = 0;
+    stats = (RewindStats){ 0 };
+}
+
+void RewindRecord(const GameState *game)
+{
+    int size = SnapshotSave(game, snapshot, sizeof(snapshot));
+    if (size == 0) return;
+
+    if (frameCount > 0)
+    {
+        // Simulation does not advance while the game is over
+        if ((game->simTick == referenceTick) && (size == lastSize) && (memcmp(snapshot, lastSnapshot, size) == 0)) return;
+
+        // Resuming after a seek replaces the history that followed it
+        if (game->simTick == (referenceTick + 1)) DropNewerFrames((int)(referenceTick - GetFrame(0)->tick) + 1);
+        else RewindReset();
+    }
+
+    if (frameCount == REWIND_MAX_FRAMES) DropOldestChain();
+
+    bool keyframe = (frameCount == 0) || (sinceKeyframe >= REWIND_KEYFRAME_INTERVAL);
+    int encodedSize = EncodeDelta(snapshot, size, keyframe? NULL : lastSnapshot, lastSize, encoded);
+    int offset = ReserveMemory(encodedSize);
+
+    // Making room dropped the chain this delta belongs to
+    if (!keyframe && (frameCount == 0))
+    {
+        keyframe = true;
+        encodedSize = EncodeDelta(snapshot, size, NULL, 0, encoded);
+        offset = ReserveMemory(encodedSize);
+    }
+
+    memcpy(memory + offset, encoded, encodedSize);
+    writePosition = offset + encodedSize;
+
+    frameCount++;
+    *GetFrame(frameCount - 1) = (RewindFrame){ game->simTick, offset, encodedSize, size, keyframe };
+
+    memcpy(lastSnapshot, snapshot, size);
+    lastSize = size;
+    referenceTick = game->simTick;
+    sinceKeyframe = keyframe? 1 : sinceKeyframe + 1;
+
+    stats.frames = frameCount;
+    if (keyframe) stats.keyframes++;
+    stats.firstTick = GetFrame(0)->tick;
+    stats.lastTick = game->simTick;
+    stats.memoryUsed += encodedSize;
+    stats.snapshotBytes += size;
+}
+
+bool RewindSeek(GameState *game, unsigned int tick)
+{
+    if ((frameCount == 0) || (tick < GetFrame(0)->tick) || (tick > GetFrame(frameCount - 1)->tick)) return false;
+
+    // Recorded ticks are consecutive
+    int index = (int)(tick - GetFrame(0)->tick);
+    int chainStart = index;
+    while (!GetFrame(chainStart)->keyframe) chainStart--;
+
+    int size = 0;
+
+    for (int i = chainStart; i <= index; i++)
+    {
+        RewindFrame *frame = GetFrame(i);
+
+        if (frame->keyframe) size = 0;
+        if (frame->size > size) memset(snapshot + size, 0, frame->size - size);
+
+        if (!DecodeDelta(memory + frame->offset, frame->encodedSize, snapshot, frame->size)) return false;
+        size = frame->size;
+    }
+
+    if (!SnapshotLoad(game, snapshot, size)) return false;
+
+    memcpy(lastSnapshot, snapshot, size);
+    lastSize = size;
+    referenceTick = tick;
+    sinceKeyframe = index - chainStart + 1;
+
+    return true;
+}
+
+RewindStats RewindGetStats(void)
+{
+    return stats;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Get frame by age, 0 is the oldest
+static RewindFrame *GetFrame(int index)
+{
+    return &frames[(firstFrame + index)%REWIND_MAX_FRAMES];
+}
+
+// Drop the oldest keyframe and its deltas, history always starts with a keyframe
+static void DropOldestChain(void)
+{
+    do
+    {
+        RewindFrame *frame = GetFrame(0);
+        if (frame->keyframe) stats.keyframes--;
+        stats.memoryUsed -= frame->encodedSize;
+        stats.snapshotBytes -= frame->size;
+
+        firstFrame = (firstFrame + 1)%REWIND_MAX_FRAMES;
+        frameCount--;
+    } while ((frameCount > 0) && !GetFrame(0)->keyframe);
+
+    stats.frames = frameCount;
+    if (frameCount > 0) stats.firstTick = GetFrame(0)->tick;
+    else RewindReset();
+}
+
+// Keep only the oldest count frames
+static void DropNewerFrames(int count)
+{
+    while (frameCount > count)
+    {
+        RewindFrame *frame = GetFrame(frameCount - 1);
+        if (frame->keyframe) stats.keyframes--;
+        stats.memoryUsed -= frame->encodedSize;
+        stats.snapshotBytes -= frame->size;
+
+        frameCount--;
+    }
+
+    RewindFrame *last = GetFrame(frameCount - 1);
+    writePosition = last->offset + last->encodedSize;
+
+    stats.frames = frameCount;
+    stats.lastTick = last->tick;
+}
+
+// Find room for an encoded frame, dropping old history if needed, returns its offset
+static int ReserveMemory(int size)
+{
+    while (frameCount > 0)
+    {
+        int oldest = GetFrame(0)->offset;
+
+        if (writePosition > oldest)
+        {
+            if ((writePosition + size) <= REWIND_MEMORY) return writePosition;
+            if (size <= oldest) return 0;
+        }
+        else if ((writePosition + size) <= oldest) return writePosition;
+
+        DropOldestChain();
+    }
+
+    return 0;
+}
+
+static unsigned char GetDeltaByte(const unsigned char *data, const unsigned char *reference, int referenceSize, int i)
+{
+    return (unsigned char)(data[i]^(((reference != NULL) && (i < referenceSize))? reference[i] : 0));
+}
+
+static int EncodeDelta(const unsigned char *data, int size, const unsigned char *reference, int referenceSize, unsigned char *output)
+{
+    int length = 0;
+    int i = 0;
+
+    while (i < size)
+    {
+        int zeros = 0;
+        while ((i < size) && (zeros < 255) && (GetDeltaByte(data, reference, referenceSize, i) == 0)) { zeros++; i++; }
+
+        // Literal runs continue over single unchanged bytes, a new token costs two
+        int literals = 0;
+        unsigned char *literal = output + length + 2;
+
+        while ((i < size) && (literals < 255))
+        {
+            if ((GetDeltaByte(data, reference, referenceSize, i) == 0) && ((i + 1) < size) && (GetDeltaByte(data, reference, referenceSize, i + 1) == 0)) break;
+            literal[literals++] = GetDeltaByte(data, reference, referenceSize, i);
+            i++;
+        }
+
+        output[length] = (unsigned char)zeros;
+        output[length + 1] = (unsigned char)literals;
+        length += 2 + literals;
+    }
+
+    return length;
+}
+
+// Apply encoded delta over data holding the reference snapshot
+static bool DecodeDelta(const unsigned char *input, int inputSize, unsigned char *data, int size)
+{
+    int i = 0;
+    int position = 0;
+
+    while ((position + 2) <= inputSize)
+    {
+        i += input[position];
+        int literals = input[position + 1];
+        position += 2;
+
+        if (((i + literals) > size) || ((position + literals) > inputSize)) return false;
+
+        for (int n = 0; n < literals; n++) data[i++] ^= input[position++];
+    }
+
+    return (position == inputSize) && (i == size);
+}
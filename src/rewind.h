@@ -0,0 +1,68 @@
+/*******************************************************************************************
+*
+*   rewind - Recent game history, step back to any recorded tick and resume from there
+*
+*   The game state is recorded after every tick as a snapshot (see snapshot.h), stored as
+*   the XOR against the previous tick snapshot, run-length encoded. Most bytes do not change
+*   between ticks (or only change in the low bits of floats) so deltas are a fraction of
+*   a full snapshot. Every REWIND_KEYFRAME_INTERVAL ticks a keyframe (delta against zeros)
+*   starts a new chain, so seeking decodes at most that many deltas.
+*
+*   History is kept in a fixed memory block used as a ring, oldest keyframe chains are
+*   dropped when recording runs out of frames or memory. With a raised MAX_ASTEROIDS less
+*   time fits in REWIND_MEMORY, memory use never grows.
+*
+*   Seeking restores the game at that tick, history is kept so it can be scrubbed back and
+*   forth while paused. Recording the tick after a seek drops the history that followed it
+*   and continues from the restored state. History restarts when the recorded tick does not
+*   follow the last recorded or seeked one (new game, quick load).
+*
+********************************************************************************************/
+
+#ifndef REWIND_H
+#define REWIND_H
+
+#include "gameplay.h"                       // Required for: GameState
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#if !defined(REWIND_SECONDS)
+    #define REWIND_SECONDS          10      // History length at the target frame rate
+#endif
+#if !defined(REWIND_MEMORY)
+    #define REWIND_MEMORY           (1024*1024)     // Bytes for encoded history, bounds memory whatever the entity caps
+#endif
+#define REWIND_TICK_RATE            60      // Game ticks per second, one tick per frame at target FPS
+#define REWIND_MAX_FRAMES           (REWIND_SECONDS*REWIND_TICK_RATE)
+#define REWIND_KEYFRAME_INTERVAL    30      // Ticks between keyframes, longest delta chain to decode on seek
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    int frames;                             // Recorded ticks
+    int keyframes;
+    unsigned int firstTick;                 // Oldest tick that can be restored
+    unsigned int lastTick;                  // Last recorded tick
+    int memoryUsed;                         // Encoded history bytes
+    int snapshotBytes;                      // Same history as full snapshots
+} RewindStats;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void RewindReset(void);                                 // Drop all recorded history
+void RewindRecord(const GameState *game);               // Record game state, call after every tick
+bool RewindSeek(GameState *game, unsigned int tick);    // Restore game at a recorded tick, false if not in history
+RewindStats RewindGetStats(void);                       // Get recorded history info
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // REWIND_H
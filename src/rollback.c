@@ -0,0 +1,236 @@
+/*******************************************************************************************
+*
+*   rollback - Rollback simulation for two peers, GGPO style
+*
+*   NOTE: Saved states are raw GameState memory, only valid in the process that saved them,
+*   use snapshots (see snapshot.h) for anything leaving the process
+*
+*   NOTE: Tick input is the local and remote inputs merged, debug overlay toggles are kept
+*   out of it by the caller
+*
+********************************************************************************************/
+
+#include "rollback.h"
+#include "net_socket.h"                     // Required for: NetGetTime()
+
+#include <stddef.h>                         // Required for: offsetof()
+#include <string.h>                         // Required for: memcpy(), memset()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define ROLLBACK_STATE_SIZE         offsetof(GameState, camera)     // Simulation fields, presentation ones start at camera
+#define ROLLBACK_NONE               0xffffffff                      // No mispredicted tick
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static const GameplayApi *api = NULL;
+
+static unsigned char states[ROLLBACK_STATES][ROLLBACK_STATE_SIZE];   // State before each tick, by tick%ROLLBACK_STATES
+static unsigned int stateFrames[ROLLBACK_STATES] = { 0 };
+
+// Inputs by tick%ROLLBACK_INPUT_HISTORY, tick + 1 in the frames arrays once set
+static unsigned char localInputs[ROLLBACK_INPUT_HISTORY] = { 0 };
+static unsigned int localFrames[ROLLBACK_INPUT_HISTORY] = { 0 };
+static unsigned char remoteInputs[ROLLBACK_INPUT_HISTORY] = { 0 };
+static unsigned int remoteFrames[ROLLBACK_INPUT_HISTORY] = { 0 };
+static unsigned char usedInputs[ROLLBACK_INPUT_HISTORY] = { 0 };    // Remote input the tick was last simulated with
+static unsigned long long hashes[ROLLBACK_INPUT_HISTORY] = { 0 };   // State hash after the tick
+
+static unsigned int frame = 0;              // Next tick to simulate
+static unsigned int remoteCount = 0;        // Remote inputs received in order, ticks 0 to remoteCount - 1
+static unsigned int rollbackFrame = ROLLBACK_NONE;
+
+static RollbackStats stats = { 0 };
+static int windowFrames = 0;                // Stats being accumulated for the next stats
+static int windowRollbacks = 0;
+static int windowMaxDepth = 0;
+static double windowRollbackTime = 0.0;
+static double windowSaveTime = 0.0;
+static double windowLoadTime = 0.0;
+static int windowLoads = 0;
+static double windowStepTime = 0.0;
+static int windowSteps = 0;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void SimulateFrame(GameState *game, unsigned int tick);
+static unsigned int GetRemoteInput(unsigned int tick);
+static void UpdateStats(void);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+void RollbackInit(const GameplayApi *gameplay)
+{
+    api = gameplay;
+    frame = 0;
+    remoteCount = 0;
+    rollbackFrame = ROLLBACK_NONE;
+
+    memset(stateFrames, 0xff, sizeof(stateFrames));
+    memset(localFrames, 0, sizeof(localFrames));
+    memset(remoteFrames, 0, sizeof(remoteFrames));
+
+    stats = (RollbackStats){ 0 };
+    stats.stateSize = (int)ROLLBACK_STATE_SIZE;
+}
+
+bool RollbackAddLocalInput(unsigned int input)
+{
+    if (frame >= (remoteCount + ROLLBACK_MAX_FRAMES)) return false;   // Remote peer may also be ahead
+
+    localInputs[frame%ROLLBACK_INPUT_HISTORY] = (unsigned char)input;
+    localFrames[frame%ROLLBACK_INPUT_HISTORY] = frame + 1;
+
+    return true;
+}
+
+void RollbackAddRemoteInput(unsigned int tick, unsigned int input)
+{
+    // Already received, or beyond what the remote peer can be ahead
+    if ((tick < remoteCount) || ((tick - remoteCount) >= (ROLLBACK_INPUT_HISTORY/2))) return;
+    if (remoteFrames[tick%ROLLBACK_INPUT_HISTORY] == (tick + 1)) return;
+
+    remoteInputs[tick%ROLLBACK_INPUT_HISTORY] = (unsigned char)input;
+    remoteFrames[tick%ROLLBACK_INPUT_HISTORY] = tick + 1;
+
+    if ((tick < frame) && (usedInputs[tick%ROLLBACK_INPUT_HISTORY] != (unsigned char)input) &&
+        ((rollbackFrame == ROLLBACK_NONE) || (tick < rollbackFrame))) rollbackFrame = tick;
+
+    while (remoteFrames[remoteCount%ROLLBACK_INPUT_HISTORY] == (remoteCount + 1)) remoteCount++;
+}
+
+void RollbackAdvance(GameState *game)
+{
+    if ((rollbackFrame != ROLLBACK_NONE) && (rollbackFrame < frame))
+    {
+        unsigned int target = rollbackFrame;
+        rollbackFrame = ROLLBACK_NONE;
+
+        if (stateFrames[target%ROLLBACK_STATES] != target)
+        {
+            TraceLog(LOG_WARNING, "ROLLBACK: Tick %u is no longer saved, peers will desync", target);
+        }
+        else
+        {
+            double start = NetGetTime();
+            bool showDebug = game->showDebug;   // Debug overlay is local, not part of the ticks
+
+            memcpy(game, states[target%ROLLBACK_STATES], ROLLBACK_STATE_SIZE);
+            game->showDebug = showDebug;
+            windowLoadTime += NetGetTime() - start;
+            windowLoads++;
+
+            // Sounds were played when the ticks were first simulated
+            bool silent = game->silent;
+            game->silent = true;
+            for (unsigned int tick = target; tick < frame; tick++) SimulateFrame(game, tick);
+            game->silent = silent;
+
+            double time = NetGetTime() - start;
+            int depth = (int)(frame - target);
+
+            windowRollbacks++;
+            if (depth > windowMaxDepth) windowMaxDepth = depth;
+            if (time > windowRollbackTime) windowRollbackTime = time;
+        }
+    }
+
+    rollbackFrame = ROLLBACK_NONE;
+
+    if (localFrames[frame%ROLLBACK_INPUT_HISTORY] != (frame + 1)) return;
+
+    SimulateFrame(game, frame);
+    frame++;
+
+    windowFrames++;
+    if (windowFrames >= GAME_TICK_RATE) UpdateStats();
+}
+
+unsigned int RollbackGetFrame(void)
+{
+    return frame;
+}
+
+unsigned int RollbackGetLocalInput(unsigned int tick)
+{
+    return (localFrames[tick%ROLLBACK_INPUT_HISTORY] == (tick + 1))? localInputs[tick%ROLLBACK_INPUT_HISTORY] : 0;
+}
+
+int RollbackGetRemoteCount(void)
+{
+    return (int)remoteCount;
+}
+
+bool RollbackGetHash(unsigned int tick, unsigned long long *hash)
+{
+    bool confirmed = (tick < remoteCount) && (tick < frame) && ((frame - tick) <= ROLLBACK_INPUT_HISTORY) &&
+                     ((rollbackFrame == ROLLBACK_NONE) || (tick < rollbackFrame));
+
+    if (confirmed) *hash = hashes[tick%ROLLBACK_INPUT_HISTORY];
+
+    return confirmed;
+}
+
+RollbackStats RollbackGetStats(void)
+{
+    stats.frame = frame;
+    stats.predictedFrames = (int)(frame - ((remoteCount < frame)? remoteCount : frame));
+
+    return stats;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Save state before the tick and simulate it with the inputs known now
+static void SimulateFrame(GameState *game, unsigned int tick)
+{
+    double start = NetGetTime();
+
+    memcpy(states[tick%ROLLBACK_STATES], game, ROLLBACK_STATE_SIZE);
+    stateFrames[tick%ROLLBACK_STATES] = tick;
+
+    double saved = NetGetTime();
+    unsigned int remote = GetRemoteInput(tick);
+
+    usedInputs[tick%ROLLBACK_INPUT_HISTORY] = (unsigned char)remote;
+    api->GameStep(game, localInputs[tick%ROLLBACK_INPUT_HISTORY] | remote);
+    hashes[tick%ROLLBACK_INPUT_HISTORY] = game->stateHash;
+
+    windowSaveTime += saved - start;
+    windowStepTime += NetGetTime() - saved;
+    windowSteps++;
+}
+
+// Remote input of a tick, predicted if not received: keys held last time, no presses
+static unsigned int GetRemoteInput(unsigned int tick)
+{
+    if (remoteFrames[tick%ROLLBACK_INPUT_HISTORY] == (tick + 1)) return remoteInputs[tick%ROLLBACK_INPUT_HISTORY];
+    if (remoteCount == 0) return 0;
+
+    return remoteInputs[(remoteCount - 1)%ROLLBACK_INPUT_HISTORY] & GAME_INPUT_HELD;
+}
+
+static void UpdateStats(void)
+{
+    stats.rollbacks = windowRollbacks;
+    stats.maxDepth = windowMaxDepth;
+    stats.rollbackTime = (float)windowRollbackTime;
+    stats.saveTime = (windowSteps > 0)? (float)(windowSaveTime/windowSteps) : 0.0f;
+    stats.loadTime = (windowLoads > 0)? (float)(windowLoadTime/windowLoads) : stats.loadTime;
+    stats.stepTime = (windowSteps > 0)? (float)(windowStepTime/windowSteps) : 0.0f;
+
+    windowFrames = 0;
+    windowRollbacks = 0;
+    windowMaxDepth = 0;
+    windowRollbackTime = 0.0;
+    windowSaveTime = 0.0;
+    windowLoadTime = 0.0;
+    windowLoads = 0;
+    windowStepTime = 0.0;
+    windowSteps = 0;
+}
@@ -0,0 +1,74 @@
+/*******************************************************************************************
+*
+*   rollback - Rollback simulation for two peers, GGPO style
+*
+*   Every peer simulates every tick as soon as its local input is known, using a prediction
+*   for the remote input: keys held in the last remote input received, no key presses. When
+*   the actual remote input for a tick arrives and differs from the prediction, the state
+*   saved before that tick is restored and every tick up to the present is simulated again,
+*   silently, with the inputs now known. Up to ROLLBACK_MAX_FRAMES ticks can be re-simulated
+*   in one frame, local simulation stalls instead of predicting further ahead than that.
+*
+*   The game has a single ship, both peers fly it: tick input is the local and remote inputs
+*   merged. Both peers must start from the same state and simulate with fixed tick time
+*   (SUPPORT_FIXED_POINT), or they will not agree on what each input did.
+*
+*   State is saved before every tick as a raw copy of the GameState simulation fields (all
+*   fields before the presentation ones), a restore is a single copy back. No serialization
+*   and no hash rebuild, see tools/rollback_bench.c for save, restore and worst case
+*   rollback costs at different asteroid caps.
+*
+********************************************************************************************/
+
+#ifndef ROLLBACK_H
+#define ROLLBACK_H
+
+#include "gameplay.h"                       // Required for: GameState, GameplayApi
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#if !defined(ROLLBACK_MAX_FRAMES)
+    #define ROLLBACK_MAX_FRAMES     16      // Ticks simulated ahead of the last confirmed remote input
+#endif
+#define ROLLBACK_STATES             (ROLLBACK_MAX_FRAMES + 2)   // Saved states, enough for the deepest rollback
+#define ROLLBACK_INPUT_HISTORY      64      // Inputs kept, covers both peers prediction windows for resends
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Rollback stats, averaged over the last second of ticks
+typedef struct {
+    unsigned int frame;                     // Next tick to simulate
+    int predictedFrames;                    // Ticks simulated without the remote input
+    int rollbacks;                          // Rollbacks in the last second
+    int maxDepth;                           // Deepest rollback in the last second, ticks re-simulated
+    float rollbackTime;                     // Worst rollback in the last second (restore and re-simulation), seconds
+    float saveTime;                         // State save, seconds
+    float loadTime;                         // State restore, seconds
+    float stepTime;                         // Tick simulation, seconds
+    int stateSize;                          // Bytes saved per tick
+} RollbackStats;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void RollbackInit(const GameplayApi *gameplay);                         // Start at tick 0, game must be in the start state agreed with the peer
+bool RollbackAddLocalInput(unsigned int input);                         // Set local input of the next tick, false if too far ahead (stall)
+void RollbackAddRemoteInput(unsigned int frame, unsigned int input);    // Set remote input of a tick, marks a rollback if it was mispredicted
+void RollbackAdvance(GameState *game);                                  // Roll back if needed, then simulate the next tick
+unsigned int RollbackGetFrame(void);                                    // Next tick to simulate
+unsigned int RollbackGetLocalInput(unsigned int frame);                 // Local input sent for a tick, for resends
+int RollbackGetRemoteCount(void);                                       // Remote ticks received in order, next one expected
+bool RollbackGetHash(unsigned int frame, unsigned long long *hash);     // State hash after a confirmed tick, false if not confirmed or too old
+RollbackStats RollbackGetStats(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // ROLLBACK_H
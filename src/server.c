@@ -0,0 +1,279 @@
+/*******************************************************************************************
+*
+*   server - Headless dedicated server, many independent matches on a fixed thread pool
+*
+*   Usage: asteroids_server [matches] [threads] [seconds]
+*
+*   No window and no audio device, only the simulation. Every match has its own GameState,
+*   random generator seed and bot flying the ship, matches share nothing. Worker threads are
+*   pinned one per core (worker i on core i%cores) and match m belongs to worker m%threads
+*   for its whole life, so its state stays in the caches of one core.
+*
+*   Every worker ticks all its matches at GAME_TICK_RATE on a fixed schedule: tick n starts
+*   at start + n/GAME_TICK_RATE. A late worker runs the next tick right away, ticks are never
+*   skipped, they are counted as overruns. When the run ends it reports tick time percentiles
+*   per match and per worker tick (all its matches), worker load and the matches per core
+*   that fit in the tick budget at the p99 match tick time.
+*
+*   NOTE: Fixed tick time is required, the server is always built with SUPPORT_FIXED_POINT
+*
+********************************************************************************************/
+
+#include "raylib.h"
+#include "gameplay.h"
+#include "thread.h"                         // Required for: Thread, ThreadStart(), ThreadJoin(), ThreadSetAffinity(), ThreadSleep()
+#include "net_socket.h"                     // Required for: NetGetTime()
+
+#include <stdio.h>                          // Required for: printf()
+#include <stdlib.h>                         // Required for: atoi(), atof(), calloc(), free()
+
+#if !defined(SUPPORT_FIXED_POINT)
+    #error "Dedicated server requires SUPPORT_FIXED_POINT, tick time comes from the frame time otherwise"
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SERVER_DEFAULT_MATCHES      64
+#define SERVER_DEFAULT_SECONDS      10
+#define SERVER_HISTOGRAM_SIZE       20000   // Tick time histogram buckets, 1 us each, last one takes anything longer
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    GameState game;
+    unsigned int botState;                  // Bot random generator state, separate from the game one
+    unsigned int botHeld;                   // Keys the bot holds
+} Match;
+
+typedef struct {
+    Thread thread;
+    int index;
+    int core;                               // Core the worker is pinned to, -1 if not pinned
+    int matchCount;
+    unsigned int ticks;                     // Ticks run, all its matches each
+    int overruns;                           // Ticks started late, previous tick did not fit in budget
+    double busyTime;                        // Time spent simulating, seconds
+    unsigned int matchTicks[SERVER_HISTOGRAM_SIZE];     // Single match tick time histogram
+    unsigned int workerTicks[SERVER_HISTOGRAM_SIZE];    // All matches tick time histogram
+} Worker;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static const GameplayApi *gameplay = NULL;
+static Match *matches = NULL;
+static int matchCount = SERVER_DEFAULT_MATCHES;
+static Worker *workers = NULL;
+static int workerCount = 0;
+static double runTime = SERVER_DEFAULT_SECONDS;
+static double startTime = 0.0;              // Tick 0 of every worker, workers start together
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void WorkerMain(void *userData);
+static unsigned int GetBotInput(Match *match);
+static void AddSample(unsigned int *histogram, double time);
+static double GetPercentile(const unsigned int *histogram, double percentile);
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    int cores = ThreadGetCoreCount();
+
+    if (argc > 1) matchCount = atoi(argv[1]);
+    workerCount = (argc > 2)? atoi(argv[2]) : cores;
+    if (argc > 3) runTime = atof(argv[3]);
+
+    if ((matchCount <= 0) || (workerCount <= 0) || (runTime <= 0.0))
+    {
+        printf("Usage: asteroids_server [matches] [threads] [seconds]\n");
+        return 1;
+    }
+
+    if (workerCount > matchCount) workerCount = matchCount;
+
+    SetTraceLogLevel(LOG_WARNING);
+    gameplay = GetGameplayApi();
+
+    matches = (Match *)calloc(matchCount, sizeof(Match));
+    workers = (Worker *)calloc(workerCount, sizeof(Worker));
+
+    if ((matches == NULL) || (workers == NULL))
+    {
+        printf("Not enough memory for %i matches\n", matchCount);
+        free(matches);
+        free(workers);
+        return 1;
+    }
+
+    // Every match gets its own seeds, same command line gives the same matches
+    for (int i = 0; i < matchCount; i++)
+    {
+        Match *match = &matches[i];
+
+        match->game.rngState = 0x9e3779b9u*(unsigned int)(i + 1);
+        match->game.spawnInvincibility = SIM(2.0f);
+        match->game.viewSize = (Vector2){ 800, 450 };
+        match->game.viewScale = 1.0f;
+        match->game.silent = true;          // No audio device
+        match->botState = 0x85ebca6bu*(unsigned int)(i + 1);
+        gameplay->GameReset(&match->game);
+    }
+
+    printf("Running %i matches on %i workers (%i cores) for %.0f s at %i ticks per second\n", matchCount, workerCount, cores, runTime, GAME_TICK_RATE);
+
+    startTime = NetGetTime() + 0.1;         // Time for every worker to start and pin itself
+
+    for (int i = 0; i < workerCount; i++)
+    {
+        workers[i].index = i;
+        workers[i].matchCount = matchCount/workerCount + ((i < (matchCount%workerCount))? 1 : 0);
+
+        if (!ThreadStart(&workers[i].thread, WorkerMain, &workers[i]))
+        {
+            printf("Threads are not available\n");
+            return 1;
+        }
+    }
+
+    for (int i = 0; i < workerCount; i++) ThreadJoin(&workers[i].thread);
+
+    // Report, histograms of every worker are merged for the totals
+    static unsigned int matchTicks[SERVER_HISTOGRAM_SIZE] = { 0 };
+    static unsigned int workerTicks[SERVER_HISTOGRAM_SIZE] = { 0 };
+    double budget = 1.0/GAME_TICK_RATE;
+    double busyTime = 0.0;
+    int overruns = 0;
+
+    printf("\nWorker   Core   Matches   Load    p50 tick   p99 tick   Overruns\n");
+
+    for (int i = 0; i < workerCount; i++)
+    {
+        Worker *worker = &workers[i];
+
+        for (int b = 0; b < SERVER_HISTOGRAM_SIZE; b++)
+        {
+            matchTicks[b] += worker->matchTicks[b];
+            workerTicks[b] += worker->workerTicks[b];
+        }
+
+        busyTime += worker->busyTime;
+        overruns += worker->overruns;
+
+        printf("%6i   %4i   %7i   %4.1f%%   %6.3f ms   %6.3f ms   %8i\n", i, worker->core, worker->matchCount,
+            (worker->ticks > 0)? worker->busyTime/(worker->ticks*budget)*100.0 : 0.0, GetPercentile(worker->workerTicks, 0.5)*1000.0,
+            GetPercentile(worker->workerTicks, 0.99)*1000.0, worker->overruns);
+    }
+
+    int coresUsed = (workerCount < cores)? workerCount : cores;
+    double workerP99 = GetPercentile(workerTicks, 0.99);
+    double matchP99 = GetPercentile(matchTicks, 0.99);
+
+    printf("\nMatch tick:  p50 %.1f us, p90 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us\n",
+        GetPercentile(matchTicks, 0.5)*1000000.0, GetPercentile(matchTicks, 0.9)*1000000.0,
+        matchP99*1000000.0, GetPercentile(matchTicks, 0.999)*1000000.0, GetPercentile(matchTicks, 1.0)*1000000.0);
+    printf("Worker tick: p50 %.3f ms, p99 %.3f ms, max %.3f ms of %.3f ms budget, %i overruns\n",
+        GetPercentile(workerTicks, 0.5)*1000.0, workerP99*1000.0, GetPercentile(workerTicks, 1.0)*1000.0, budget*1000.0, overruns);
+    printf("Matches per core: %.1f hosted, %.0f fit at p99 match tick, %.1f%% load on %i cores\n",
+        (double)matchCount/coresUsed, (matchP99 > 0.0)? budget/matchP99 : 0.0, busyTime/(runTime*coresUsed)*100.0, coresUsed);
+
+    free(matches);
+    free(workers);
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Tick worker matches on schedule until run time is over
+static void WorkerMain(void *userData)
+{
+    Worker *worker = (Worker *)userData;
+    double budget = 1.0/GAME_TICK_RATE;
+    unsigned int tickCount = (unsigned int)(runTime*GAME_TICK_RATE);
+
+    worker->core = ThreadSetAffinity(worker->index%ThreadGetCoreCount())? worker->index%ThreadGetCoreCount() : -1;
+
+    for (unsigned int tick = 0; tick < tickCount; tick++)
+    {
+        double tickStart = startTime + tick*budget;
+        double now = NetGetTime();
+
+        if (now < tickStart) ThreadSleep(tickStart - now);
+        else if (tick > 0) worker->overruns++;
+
+        double workerStart = NetGetTime();
+        double matchStart = workerStart;
+
+        for (int m = worker->index; m < matchCount; m += workerCount)
+        {
+            Match *match = &matches[m];
+            gameplay->GameStep(&match->game, GetBotInput(match));
+
+            double matchEnd = NetGetTime();
+            AddSample(worker->matchTicks, matchEnd - matchStart);
+            matchStart = matchEnd;
+        }
+
+        AddSample(worker->workerTicks, matchStart - workerStart);
+        worker->busyTime += matchStart - workerStart;
+        worker->ticks++;
+    }
+}
+
+// Bot turns and thrusts in random bursts, shoots often and restarts when the game is over
+static unsigned int GetBotInput(Match *match)
+{
+    // Xorshift, same generator as gameplay code
+    match->botState ^= match->botState << 13;
+    match->botState ^= match->botState >> 17;
+    match->botState ^= match->botState << 5;
+
+    unsigned int random = match->botState;
+
+    if ((random%30) == 0) match->botHeld = (random >> 8) & GAME_INPUT_HELD;
+
+    unsigned int input = match->botHeld | GAME_INPUT_RESTART;
+    if (((random >> 16)%6) == 0) input |= GAME_INPUT_SHOOT;
+    if (((random >> 20)%120) == 0) input |= GAME_INPUT_BEAM;
+
+    return input;
+}
+
+static void AddSample(unsigned int *histogram, double time)
+{
+    int bucket = (int)(time*1000000.0);
+
+    if (bucket < 0) bucket = 0;
+    else if (bucket >= SERVER_HISTOGRAM_SIZE) bucket = SERVER_HISTOGRAM_SIZE - 1;
+
+    histogram[bucket]++;
+}
+
+// Get time below which the given fraction of samples are, seconds, bucket upper bound
+static double GetPercentile(const unsigned int *histogram, double percentile)
+{
+    unsigned long long total = 0;
+    for (int b = 0; b < SERVER_HISTOGRAM_SIZE; b++) total += histogram[b];
+
+    if (total == 0) return 0.0;
+
+    unsigned long long target = (unsigned long long)(percentile*(double)total);
+    if (target == 0) target = 1;
+
+    unsigned long long count = 0;
+
+    for (int b = 0; b < SERVER_HISTOGRAM_SIZE; b++)
+    {
+        count += histogram[b];
+        if (count >= target) return (b + 1)/1000000.0;
+    }
+
+    return SERVER_HISTOGRAM_SIZE/1000000.0;
+}
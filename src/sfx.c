@@ -0,0 +1,485 @@
+/*******************************************************************************************
+*
+*   sfx - Sound effects voice pool
+*
+*   NOTE: Voices are created with LoadSoundAlias(), they share the sample data of the source
+*   sound so the pool costs one small audio buffer per voice
+*
+*   NOTE: With SUPPORT_SFX_MIXER, triggers are handed to the audio thread through a single
+*   producer/single consumer queue, mixer voices are only touched by the audio thread
+*
+********************************************************************************************/
+
+#include "sfx.h"
+
+#include <string.h>                         // Required for: memset()
+
+#if defined(SUPPORT_SFX_MIXER)
+    #if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))
+        #include <xmmintrin.h>              // Required for: SSE intrinsics
+        #define SFX_MIXER_SSE
+    #endif
+
+    #include "thread.h"                     // Required for: ATOMIC_LOAD(), ATOMIC_STORE(), trigger queue indices
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SFX_MIXER_QUEUE_SIZE        64      // Trigger queue size, must be power of two
+#define SFX_LIMITER_THRESHOLD       0.7f    // Mix level where the soft limiter starts compressing
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    int sound;
+    float volume;
+    float pan;
+} SfxTrigger;
+
+#if defined(SUPPORT_SFX_MIXER)
+typedef struct {
+    Wave wave;                              // Converted to mixer format: 32bit float, stereo, mixer sample rate
+    unsigned int frameCount;
+    bool owned;                             // Wave was converted by the pool, otherwise it references caller data
+} MixerSound;
+
+typedef struct {
+    int sound;
+    unsigned int cursor;                    // Next frame to mix
+    unsigned int startCounter;              // Start order, used for stealing
+    float gainLeft;
+    float gainRight;
+    bool active;
+} MixerVoice;
+#else
+typedef struct {
+    Sound alias;                            // Alias of the source sound
+    unsigned int startTick;                 // Tick the voice was last started, used for stealing
+} SfxVoice;
+#endif
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static SfxTrigger pending[SFX_MAX_SOUNDS] = { 0 };  // First trigger queued this tick, per sound
+static int pendingCount[SFX_MAX_SOUNDS] = { 0 };    // Triggers queued this tick, per sound
+static bool loaded[SFX_MAX_SOUNDS] = { 0 };
+static bool ready = false;                          // Initialized with a working audio device
+static unsigned int tick = 0;
+static SfxStats stats = { 0 };
+
+#if defined(SUPPORT_SFX_MIXER)
+static MixerSound mixerSounds[SFX_MAX_SOUNDS] = { 0 };
+static SfxTrigger mixerQueue[SFX_MIXER_QUEUE_SIZE] = { 0 };
+static unsigned int mixerQueueWrite = 0;            // Written by main thread only
+static unsigned int mixerQueueRead = 0;             // Written by audio thread only
+static MixerVoice mixerVoices[SFX_MIXER_MAX_VOICES] = { 0 };    // Audio thread only
+static unsigned int mixerStartCounter = 0;          // Audio thread only
+static unsigned int mixerActiveVoices = 0;          // Written by audio thread, stats
+static unsigned int mixerStolen = 0;                // Written by audio thread, stats
+static unsigned int mixerFrames = 0;                // Written by audio thread, stats
+static unsigned int mixerTime = 0;                  // Written by audio thread, stats, microseconds
+static AudioStream mixerStream = { 0 };
+#else
+static Sound sources[SFX_MAX_SOUNDS] = { 0 };
+static SfxVoice voices[SFX_MAX_SOUNDS][SFX_VOICES_PER_SOUND] = { 0 };
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static bool LoadSoundSlot(int sound, Wave wave, bool shared);
+static void UnloadSoundSlot(int sound);
+
+#if defined(SUPPORT_SFX_MIXER)
+static void MixerStart(void);
+static void MixerStop(void);
+static void MixerCallback(void *bufferData, unsigned int frames);
+static void MixerStartVoice(const SfxTrigger *trigger);
+static void MixVoice(float *out, const float *in, unsigned int frames, float gainLeft, float gainRight);
+static void SoftLimit(float *samples, unsigned int count);
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+void SfxInit(void)
+{
+    memset(pendingCount, 0, sizeof(pendingCount));
+    memset(loaded, 0, sizeof(loaded));
+    stats = (SfxStats){ 0 };
+
+    // Without audio device the pool stays empty and every trigger is dropped
+    ready = IsAudioDeviceReady();
+    if (!ready) return;
+
+#if defined(SUPPORT_SFX_MIXER)
+    stats.voices = SFX_MIXER_MAX_VOICES;
+    MixerStart();
+#endif
+}
+
+void SfxShutdown(void)
+{
+    if (!ready) return;
+
+#if defined(SUPPORT_SFX_MIXER)
+    MixerStop();                            // Stops the callback before releasing sample data
+#endif
+
+    for (int s = 0; s < SFX_MAX_SOUNDS; s++) UnloadSoundSlot(s);
+
+    ready = false;
+}
+
+bool SfxLoadWave(int sound, Wave wave)
+{
+    return LoadSoundSlot(sound, wave, false);
+}
+
+bool SfxLoadWaveShared(int sound, Wave wave)
+{
+    return LoadSoundSlot(sound, wave, true);
+}
+
+bool SfxReloadWave(int sound, Wave wave)
+{
+    if (!ready || (sound < 0) || (sound >= SFX_MAX_SOUNDS) || (wave.data == NULL)) return false;
+
+#if defined(SUPPORT_SFX_MIXER)
+    // Mixer voices read sample data from the audio thread, the stream is stopped while swapping
+    MixerStop();
+#endif
+
+    UnloadSoundSlot(sound);
+    bool result = LoadSoundSlot(sound, wave, false);
+
+#if defined(SUPPORT_SFX_MIXER)
+    MixerStart();
+#endif
+
+    return result;
+}
+
+void SfxPlay(int sound)
+{
+    SfxPlayEx(sound, 1.0f, 0.5f);
+}
+
+void SfxPlayEx(int sound, float volume, float pan)
+{
+    if ((sound < 0) || (sound >= SFX_MAX_SOUNDS) || !loaded[sound]) return;
+
+    if (pendingCount[sound] == 0) pending[sound] = (SfxTrigger){ sound, volume, pan };
+    else if (volume > pending[sound].volume) pending[sound].volume = volume;
+
+    pendingCount[sound]++;
+}
+
+void SfxUpdate(void)
+{
+    tick++;
+    stats.triggers = 0;
+    stats.coalesced = 0;
+
+#if defined(SUPPORT_SFX_MIXER)
+    for (int s = 0; s < SFX_MAX_SOUNDS; s++)
+    {
+        if (pendingCount[s] == 0) continue;
+
+        // Identical triggers in the same tick would start in phase, only one is played
+        stats.triggers += pendingCount[s];
+        stats.coalesced += pendingCount[s] - 1;
+        pendingCount[s] = 0;
+
+        // Queue full means the audio thread is stalled, trigger is dropped
+        if ((mixerQueueWrite - ATOMIC_LOAD(&mixerQueueRead)) < SFX_MIXER_QUEUE_SIZE)
+        {
+            mixerQueue[mixerQueueWrite & (SFX_MIXER_QUEUE_SIZE - 1)] = pending[s];
+            ATOMIC_STORE(&mixerQueueWrite, mixerQueueWrite + 1);
+        }
+    }
+
+    stats.activeVoices = (int)ATOMIC_LOAD(&mixerActiveVoices);
+    stats.stolen = (int)ATOMIC_LOAD(&mixerStolen);
+    stats.mixFrames = (int)ATOMIC_LOAD(&mixerFrames);
+    stats.mixTime = (float)ATOMIC_LOAD(&mixerTime)/1000.0f;
+#else
+    stats.activeVoices = 0;
+
+    for (int s = 0; s < SFX_MAX_SOUNDS; s++)
+    {
+        if (!loaded[s]) continue;
+
+        int freeVoice = -1;
+        int oldestVoice = 0;
+
+        for (int v = 0; v < SFX_VOICES_PER_SOUND; v++)
+        {
+            if (IsSoundPlaying(voices[s][v].alias)) stats.activeVoices++;
+            else if (freeVoice == -1) freeVoice = v;
+
+            if (voices[s][v].startTick < voices[s][oldestVoice].startTick) oldestVoice = v;
+        }
+
+        if (pendingCount[s] > 0)
+        {
+            // Identical triggers in the same tick would start in phase, only one is played
+            stats.triggers += pendingCount[s];
+            stats.coalesced += pendingCount[s] - 1;
+            pendingCount[s] = 0;
+
+            int voice = freeVoice;
+
+            if (voice == -1)
+            {
+                voice = oldestVoice;
+                StopSound(voices[s][voice].alias);
+                stats.stolen++;
+            }
+            else stats.activeVoices++;
+
+            SetSoundVolume(voices[s][voice].alias, pending[s].volume);
+            SetSoundPan(voices[s][voice].alias, pending[s].pan);
+            PlaySound(voices[s][voice].alias);
+            voices[s][voice].startTick = tick;
+        }
+    }
+#endif
+}
+
+SfxStats SfxGetStats(void)
+{
+    return stats;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+static bool LoadSoundSlot(int sound, Wave wave, bool shared)
+{
+    if (!ready || (sound < 0) || (sound >= SFX_MAX_SOUNDS) || loaded[sound] || (wave.data == NULL)) return false;
+
+#if defined(SUPPORT_SFX_MIXER)
+    // Waves already in mixer format (i.e. from the PCM cache) are mixed straight from their memory
+    bool mixerFormat = (wave.sampleRate == SFX_MIXER_SAMPLE_RATE) && (wave.sampleSize == 32) && (wave.channels == 2);
+
+    if (shared && mixerFormat) mixerSounds[sound].wave = wave;
+    else
+    {
+        mixerSounds[sound].wave = WaveCopy(wave);
+        WaveFormat(&mixerSounds[sound].wave, SFX_MIXER_SAMPLE_RATE, 32, 2);
+    }
+
+    mixerSounds[sound].frameCount = mixerSounds[sound].wave.frameCount;
+    mixerSounds[sound].owned = !(shared && mixerFormat);
+#else
+    (void)shared;                           // Sounds always copy wave data into their own buffer
+    sources[sound] = LoadSoundFromWave(wave);
+    for (int v = 0; v < SFX_VOICES_PER_SOUND; v++)
+    {
+        voices[sound][v].alias = LoadSoundAlias(sources[sound]);
+        voices[sound][v].startTick = 0;
+    }
+    stats.voices += SFX_VOICES_PER_SOUND;
+#endif
+
+    loaded[sound] = true;
+
+    return true;
+}
+
+static void UnloadSoundSlot(int sound)
+{
+    if (!loaded[sound]) return;
+
+#if defined(SUPPORT_SFX_MIXER)
+    if (mixerSounds[sound].owned) UnloadWave(mixerSounds[sound].wave);
+    mixerSounds[sound] = (MixerSound){ 0 };
+#else
+    for (int v = 0; v < SFX_VOICES_PER_SOUND; v++) UnloadSoundAlias(voices[sound][v].alias);
+    UnloadSound(sources[sound]);
+    stats.voices -= SFX_VOICES_PER_SOUND;
+#endif
+
+    loaded[sound] = false;
+}
+
+#if defined(SUPPORT_SFX_MIXER)
+// Create mixer stream and start the callback, all voices start idle
+static void MixerStart(void)
+{
+    memset(mixerVoices, 0, sizeof(mixerVoices));
+    mixerQueueWrite = 0;
+    mixerQueueRead = 0;
+    mixerActiveVoices = 0;
+
+    SetAudioStreamBufferSizeDefault(SFX_MIXER_BUFFER_FRAMES);
+    mixerStream = LoadAudioStream(SFX_MIXER_SAMPLE_RATE, 32, 2);
+    SetAudioStreamBufferSizeDefault(0);
+
+    SetAudioStreamCallback(mixerStream, MixerCallback);
+    PlayAudioStream(mixerStream);
+}
+
+// Destroy mixer stream, the callback is not running anymore once it returns
+static void MixerStop(void)
+{
+    UnloadAudioStream(mixerStream);
+    mixerStream = (AudioStream){ 0 };
+}
+
+// Audio thread callback, mixes all active voices into the stream buffer
+static void MixerCallback(void *bufferData, unsigned int frames)
+{
+    double startTime = GetTime();
+    float *out = (float *)bufferData;
+
+    memset(out, 0, frames*2*sizeof(float));
+
+    unsigned int write = ATOMIC_LOAD(&mixerQueueWrite);
+    unsigned int read = mixerQueueRead;
+
+    while (read != write)
+    {
+        MixerStartVoice(&mixerQueue[read & (SFX_MIXER_QUEUE_SIZE - 1)]);
+        read++;
+    }
+
+    ATOMIC_STORE(&mixerQueueRead, read);
+
+    unsigned int activeVoices = 0;
+
+    for (int v = 0; v < SFX_MIXER_MAX_VOICES; v++)
+    {
+        MixerVoice *voice = &mixerVoices[v];
+
+        if (!voice->active) continue;
+
+        const MixerSound *sound = &mixerSounds[voice->sound];
+        unsigned int remaining = sound->frameCount - voice->cursor;
+        unsigned int count = (frames < remaining)? frames : remaining;
+
+        MixVoice(out, (const float *)sound->wave.data + voice->cursor*2, count, voice->gainLeft, voice->gainRight);
+        voice->cursor += count;
+
+        if (voice->cursor >= sound->frameCount) voice->active = false;
+        else activeVoices++;
+    }
+
+    SoftLimit(out, frames*2);
+
+    ATOMIC_STORE(&mixerActiveVoices, activeVoices);
+    ATOMIC_STORE(&mixerFrames, frames);
+    ATOMIC_STORE(&mixerTime, (unsigned int)((GetTime() - startTime)*1000000.0));
+}
+
+// Start a voice for trigger, stealing the oldest one if all voices are busy
+static void MixerStartVoice(const SfxTrigger *trigger)
+{
+    int voice = -1;
+    int oldest = 0;
+
+    for (int v = 0; v < SFX_MIXER_MAX_VOICES; v++)
+    {
+        if (!mixerVoices[v].active)
+        {
+            voice = v;
+            break;
+        }
+
+        if (mixerVoices[v].startCounter < mixerVoices[oldest].startCounter) oldest = v;
+    }
+
+    if (voice == -1)
+    {
+        voice = oldest;
+        ATOMIC_STORE(&mixerStolen, mixerStolen + 1);
+    }
+
+    // Linear pan law, center keeps both channels at full volume
+    float pan = (trigger->pan < 0.0f)? 0.0f : (trigger->pan > 1.0f)? 1.0f : trigger->pan;
+
+    mixerVoices[voice].sound = trigger->sound;
+    mixerVoices[voice].cursor = 0;
+    mixerVoices[voice].startCounter = mixerStartCounter++;
+    mixerVoices[voice].gainLeft = trigger->volume*((pan > 0.5f)? 2.0f*(1.0f - pan) : 1.0f);
+    mixerVoices[voice].gainRight = trigger->volume*((pan < 0.5f)? 2.0f*pan : 1.0f);
+    mixerVoices[voice].active = true;
+}
+
+// Accumulate interleaved stereo samples with per channel gain
+static void MixVoice(float *out, const float *in, unsigned int frames, float gainLeft, float gainRight)
+{
+    unsigned int i = 0;
+
+#if defined(SFX_MIXER_SSE)
+    __m128 gain = _mm_setr_ps(gainLeft, gainRight, gainLeft, gainRight);
+
+    // Two stereo frames per vector, four per iteration
+    for (; (i + 4) <= frames; i += 4)
+    {
+        __m128 mix0 = _mm_loadu_ps(out + i*2);
+        __m128 mix1 = _mm_loadu_ps(out + i*2 + 4);
+
+        mix0 = _mm_add_ps(mix0, _mm_mul_ps(_mm_loadu_ps(in + i*2), gain));
+        mix1 = _mm_add_ps(mix1, _mm_mul_ps(_mm_loadu_ps(in + i*2 + 4), gain));
+
+        _mm_storeu_ps(out + i*2, mix0);
+        _mm_storeu_ps(out + i*2 + 4, mix1);
+    }
+#endif
+
+    for (; i < frames; i++)
+    {
+        out[i*2] += in[i*2]*gainLeft;
+        out[i*2 + 1] += in[i*2 + 1]*gainRight;
+    }
+}
+
+// Soft limiter, samples under threshold pass unchanged, over it they are
+// compressed with a rational tanh approximation so the mix never clips
+// NOTE: Branchless, min(|x|, T) + (1 - T)*tanh(max(|x| - T, 0)/(1 - T))
+static void SoftLimit(float *samples, unsigned int count)
+{
+    const float threshold = SFX_LIMITER_THRESHOLD;
+    const float knee = 1.0f - SFX_LIMITER_THRESHOLD;
+    unsigned int i = 0;
+
+#if defined(SFX_MIXER_SSE)
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 vthreshold = _mm_set1_ps(threshold);
+    const __m128 vknee = _mm_set1_ps(knee);
+    const __m128 vinvKnee = _mm_set1_ps(1.0f/knee);
+    const __m128 vzero = _mm_setzero_ps();
+    const __m128 vthree = _mm_set1_ps(3.0f);
+    const __m128 v9 = _mm_set1_ps(9.0f);
+    const __m128 v27 = _mm_set1_ps(27.0f);
+
+    for (; (i + 4) <= count; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(samples + i);
+        __m128 a = _mm_andnot_ps(signMask, x);
+        __m128 u = _mm_min_ps(_mm_mul_ps(_mm_max_ps(_mm_sub_ps(a, vthreshold), vzero), vinvKnee), vthree);
+        __m128 u2 = _mm_mul_ps(u, u);
+        __m128 t = _mm_div_ps(_mm_mul_ps(u, _mm_add_ps(v27, u2)), _mm_add_ps(v27, _mm_mul_ps(v9, u2)));
+        __m128 magnitude = _mm_add_ps(_mm_min_ps(a, vthreshold), _mm_mul_ps(vknee, t));
+
+        _mm_storeu_ps(samples + i, _mm_or_ps(magnitude, _mm_and_ps(x, signMask)));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        float x = samples[i];
+        float a = (x < 0.0f)? -x : x;
+        float u = (a > threshold)? (a - threshold)/knee : 0.0f;
+        if (u > 3.0f) u = 3.0f;
+
+        float magnitude = ((a < threshold)? a : threshold) + knee*u*(27.0f + u*u)/(27.0f + 9.0f*u*u);
+        samples[i] = (x < 0.0f)? -magnitude : magnitude;
+    }
+}
+#endif
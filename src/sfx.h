@@ -0,0 +1,71 @@
+/*******************************************************************************************
+*
+*   sfx - Sound effects voice pool
+*
+*   Every source sound gets a fixed number of voices (sound aliases sharing its sample data),
+*   so overlapping effects do not cut each other off. Triggers are queued with SfxPlay() and
+*   dispatched once per tick by SfxUpdate(), identical triggers in the same tick are coalesced
+*   into a single voice. When all voices of a sound are busy the oldest one is stolen.
+*
+*   Sounds triggered before they are loaded, or without a working audio device, are dropped.
+*
+*   CONFIGURATION:
+*       #define SUPPORT_SFX_MIXER
+*           Mix all voices in a single audio stream callback instead of letting raylib play
+*           every voice as an independent sound. Voices are accumulated with SIMD gain/pan
+*           and the mix goes through a soft limiter, cost is linear in active voices and the
+*           callback time is reported in SfxStats
+*
+********************************************************************************************/
+
+#ifndef SFX_H
+#define SFX_H
+
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SFX_MAX_SOUNDS              4       // Maximum source sounds managed by the pool
+#define SFX_VOICES_PER_SOUND        4       // Voices (aliases) per source sound
+
+#define SFX_MIXER_MAX_VOICES        32      // Mixer voices shared by all sounds
+#define SFX_MIXER_SAMPLE_RATE       44100   // Mixer stream sample rate, sounds are converted on load
+#define SFX_MIXER_BUFFER_FRAMES     512     // Mixer stream buffer size, lower is less latency
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Voice pool stats, updated on SfxUpdate()
+typedef struct {
+    int voices;                             // Total voices in the pool
+    int activeVoices;                       // Voices currently playing
+    int triggers;                           // SfxPlay() calls last tick
+    int coalesced;                          // Triggers merged into another one last tick
+    int stolen;                             // Voices stolen since init
+    float mixTime;                          // Last mixer callback time in milliseconds (SUPPORT_SFX_MIXER)
+    int mixFrames;                          // Frames mixed on last mixer callback (SUPPORT_SFX_MIXER)
+} SfxStats;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void SfxInit(void);                                     // Init voice pool (audio device must be ready)
+void SfxShutdown(void);                                 // Unload all sounds and voices
+bool SfxLoadWave(int sound, Wave wave);                 // Load sound slot from wave data, wave is not unloaded
+bool SfxLoadWaveShared(int sound, Wave wave);           // Load sound slot, wave data may be referenced until SfxShutdown()
+bool SfxReloadWave(int sound, Wave wave);               // Replace loaded sound slot, stops playing voices (hot reload)
+void SfxPlay(int sound);                                // Queue a sound trigger for this tick
+void SfxPlayEx(int sound, float volume, float pan);     // Queue a sound trigger with volume and pan (0.5 is center)
+void SfxUpdate(void);                                   // Dispatch queued triggers, call once per tick
+SfxStats SfxGetStats(void);                             // Get voice pool stats
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // SFX_H
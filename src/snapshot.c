@@ -0,0 +1,220 @@
+/*******************************************************************************************
+*
+*   snapshot - Game state save and restore
+*
+*   NOTE: Snapshot buffers may not be aligned, records are copied in and out with memcpy()
+*
+********************************************************************************************/
+
+#include "snapshot.h"
+
+#include <string.h>                         // Required for: memcpy(), memcmp()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#if defined(SUPPORT_FIXED_POINT)
+    #define SNAPSHOT_FLAGS          SNAPSHOT_FLAG_FIXED_POINT
+#else
+    #define SNAPSHOT_FLAGS          0
+#endif
+
+// Records layout must not depend on compiler padding
+typedef char SnapshotHeaderSizeCheck[(sizeof(SnapshotHeader) == 32)? 1 : -1];
+typedef char SnapshotEntitySizeCheck[(sizeof(SnapshotEntity) == 36)? 1 : -1];
+typedef char SnapshotAsteroidSizeCheck[(sizeof(SnapshotAsteroid) == 32)? 1 : -1];
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static SnapshotEntity SaveEntity(const sEntity *entity);
+static void LoadEntity(sEntity *entity, const SnapshotEntity *saved);
+static bool IsValidEntityType(int type, int first, int last);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+int SnapshotSave(const GameState *game, unsigned char *buffer, int bufferSize)
+{
+    int size = (int)(sizeof(SnapshotHeader) + sizeof(SnapshotGame));
+    if (bufferSize < size) return 0;
+
+    SnapshotGame state = { 0 };
+    state.rngState = game->rngState;
+    state.stateHash[0] = (unsigned int)(game->stateHash & 0xffffffffULL);
+    state.stateHash[1] = (unsigned int)(game->stateHash >> 32);
+    state.player = SaveEntity(&game->sPlayer);
+    state.superBeam = SaveEntity(&game->sSuperBeam);
+    for (int i = 0; i < MAX_SHOTS; i++) state.shots[i] = SaveEntity(&game->sShots[i]);
+    for (int i = 0; i < MAX_LIVES; i++) state.lives[i] = SaveEntity(&game->sLives[i]);
+    state.asteroidScore = game->asteroidScore;
+    state.currentAsteroids = game->currentAsteroids;
+    state.livesCount = game->lives;
+    state.beamCharge = game->beamCharge;
+    state.beamDelay = game->beamDelay;
+    state.spawnInvincibility = game->spawnInvincibility;
+    state.isGameOver = game->isGameOver;
+    state.preDetonation = game->preDetonation;
+    memcpy(state.chunkLastTick, game->chunkLastTick, sizeof(state.chunkLastTick));
+    memcpy(state.chunkVisitTick, game->chunkVisitTick, sizeof(state.chunkVisitTick));
+
+    memcpy(buffer + sizeof(SnapshotHeader), &state, sizeof(SnapshotGame));
+
+    // Asteroids in chunk list order, restore links them back in reverse to get the same lists
+    unsigned int count = 0;
+
+    for (int chunk = 0; chunk < MAX_CHUNKS; chunk++)
+    {
+        for (int i = game->chunkFirst[chunk]; i != -1; i = game->asteroidNext[i])
+        {
+            if ((size + (int)sizeof(SnapshotAsteroid)) > bufferSize) return 0;
+
+            SnapshotAsteroid asteroid = {
+                (unsigned int)i, (unsigned int)chunk,
+                { game->sAsteroids[i].position.x, game->sAsteroids[i].position.y },
+                { game->sAsteroids[i].speed.x, game->sAsteroids[i].speed.y },
+                game->sAsteroids[i].rotation, game->sAsteroids[i].type
+            };
+
+            memcpy(buffer + size, &asteroid, sizeof(SnapshotAsteroid));
+            size += (int)sizeof(SnapshotAsteroid);
+            count++;
+        }
+    }
+
+    SnapshotHeader header = { 0 };
+    memcpy(header.magic, SNAPSHOT_MAGIC, 4);
+    header.version = SNAPSHOT_VERSION;
+    header.size = (unsigned int)size;
+    header.tick = game->simTick;
+    header.asteroidCount = count;
+    header.maxAsteroids = MAX_ASTEROIDS;
+    header.worldWidth = WORLD_WIDTH;
+    header.worldHeight = WORLD_HEIGHT;
+    header.flags = SNAPSHOT_FLAGS;
+
+    memcpy(buffer, &header, sizeof(SnapshotHeader));
+
+    return size;
+}
+
+bool SnapshotLoad(GameState *game, const unsigned char *data, int size)
+{
+    SnapshotHeader header = { 0 };
+    SnapshotGame state = { 0 };
+
+    if ((data == NULL) || (size < (int)(sizeof(SnapshotHeader) + sizeof(SnapshotGame)))) return false;
+
+    memcpy(&header, data, sizeof(SnapshotHeader));
+    memcpy(&state, data + sizeof(SnapshotHeader), sizeof(SnapshotGame));
+
+    const unsigned char *asteroids = data + sizeof(SnapshotHeader) + sizeof(SnapshotGame);
+
+    bool valid = (memcmp(header.magic, SNAPSHOT_MAGIC, 4) == 0) &&
+                 (header.version == SNAPSHOT_VERSION) &&
+                 (header.maxAsteroids == MAX_ASTEROIDS) &&
+                 (header.worldWidth == WORLD_WIDTH) && (header.worldHeight == WORLD_HEIGHT) &&
+                 (header.flags == SNAPSHOT_FLAGS) &&
+                 (header.asteroidCount <= MAX_ASTEROIDS) &&
+                 (header.size == sizeof(SnapshotHeader) + sizeof(SnapshotGame) + header.asteroidCount*sizeof(SnapshotAsteroid)) &&
+                 (header.size <= (unsigned int)size) &&
+                 (state.livesCount >= 0) && (state.livesCount <= MAX_LIVES) &&
+                 (state.player.type == TYPE_PLAYER) && IsValidEntityType(state.superBeam.type, 0, TYPE_SHOT);
+
+    // Types index sprite rectangles, shots and beam are drawn as circles and keep any entity type
+    for (int i = 0; valid && (i < MAX_SHOTS); i++) valid = IsValidEntityType(state.shots[i].type, 0, TYPE_SHOT);
+    for (int i = 0; valid && (i < MAX_LIVES); i++) valid = (state.lives[i].type == TYPE_PLAYER);
+
+    // Every slot at most once, a repeated slot would corrupt chunk lists
+    unsigned char seen[(MAX_ASTEROIDS + 7)/8] = { 0 };
+
+    for (unsigned int n = 0; valid && (n < header.asteroidCount); n++)
+    {
+        SnapshotAsteroid asteroid = { 0 };
+        memcpy(&asteroid, asteroids + n*sizeof(SnapshotAsteroid), sizeof(SnapshotAsteroid));
+
+        valid = (asteroid.slot < MAX_ASTEROIDS) && (asteroid.chunk < MAX_CHUNKS) &&
+                IsValidEntityType(asteroid.type, TYPE_ASTEROID_SMALL, TYPE_ASTEROID_LARGE) &&
+                !(seen[asteroid.slot/8] & (1 << (asteroid.slot%8)));
+
+        if (valid) seen[asteroid.slot/8] |= (unsigned char)(1 << (asteroid.slot%8));
+    }
+
+    if (!valid) return false;
+
+    game->simTick = header.tick;
+    game->rngState = state.rngState;
+    game->stateHash = ((unsigned long long)state.stateHash[1] << 32) | state.stateHash[0];
+    game->hashRebuild = true;
+    LoadEntity(&game->sPlayer, &state.player);
+    LoadEntity(&game->sSuperBeam, &state.superBeam);
+    for (int i = 0; i < MAX_SHOTS; i++) LoadEntity(&game->sShots[i], &state.shots[i]);
+    for (int i = 0; i < MAX_LIVES; i++) LoadEntity(&game->sLives[i], &state.lives[i]);
+    game->asteroidScore = state.asteroidScore;
+    game->currentAsteroids = state.currentAsteroids;
+    game->lives = state.livesCount;
+    game->beamCharge = state.beamCharge;
+    game->beamDelay = state.beamDelay;
+    game->spawnInvincibility = state.spawnInvincibility;
+    game->isGameOver = (state.isGameOver != 0);
+    game->preDetonation = (state.preDetonation != 0);
+    memcpy(game->chunkLastTick, state.chunkLastTick, sizeof(state.chunkLastTick));
+    memcpy(game->chunkVisitTick, state.chunkVisitTick, sizeof(state.chunkVisitTick));
+
+    for (int i = 0; i < MAX_ASTEROIDS; i++) game->sAsteroids[i] = (sEntity){ 0 };
+    for (int i = 0; i < MAX_CHUNKS; i++) game->chunkFirst[i] = -1;
+
+    for (int n = (int)header.asteroidCount - 1; n >= 0; n--)
+    {
+        SnapshotAsteroid asteroid = { 0 };
+        memcpy(&asteroid, asteroids + n*sizeof(SnapshotAsteroid), sizeof(SnapshotAsteroid));
+
+        int i = (int)asteroid.slot;
+        int chunk = (int)asteroid.chunk;
+
+        game->sAsteroids[i] = (sEntity){ { asteroid.position[0], asteroid.position[1] }, { asteroid.speed[0], asteroid.speed[1] },
+                                         asteroid.rotation, 0, 0, asteroid.type, true };
+
+        game->asteroidChunk[i] = chunk;
+        game->asteroidPrev[i] = -1;
+        game->asteroidNext[i] = game->chunkFirst[chunk];
+        if (game->chunkFirst[chunk] != -1) game->asteroidPrev[game->chunkFirst[chunk]] = i;
+        game->chunkFirst[chunk] = i;
+    }
+
+    game->liveAsteroids = (int)header.asteroidCount;
+
+    // Camera always follows the player between ticks
+    game->camera.target = SIM_TO_VECTOR2(game->sPlayer.position);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+static SnapshotEntity SaveEntity(const sEntity *entity)
+{
+    SnapshotEntity saved = {
+        { entity->position.x, entity->position.y }, { entity->speed.x, entity->speed.y },
+        entity->rotation, entity->acceleration, entity->lifetime, entity->type, entity->active
+    };
+
+    return saved;
+}
+
+static void LoadEntity(sEntity *entity, const SnapshotEntity *saved)
+{
+    entity->position = (SimVector2){ saved->position[0], saved->position[1] };
+    entity->speed = (SimVector2){ saved->speed[0], saved->speed[1] };
+    entity->rotation = saved->rotation;
+    entity->acceleration = saved->acceleration;
+    entity->lifetime = saved->lifetime;
+    entity->type = saved->type;
+    entity->active = (saved->active != 0);
+}
+
+static bool IsValidEntityType(int type, int first, int last)
+{
+    return (type >= first) && (type <= last);
+}
@@ -0,0 +1,107 @@
+/*******************************************************************************************
+*
+*   snapshot - Game state save and restore
+*
+*   Serializes the simulation part of GameState into a caller provided buffer and restores
+*   it, no allocations happen on either side. Restoring a snapshot and running the same
+*   inputs reproduces the same game, including random values (see GameState.rngState).
+*
+*   Only live asteroids are stored, in chunk list order, so restore rebuilds the chunk
+*   lists exactly as they were. Presentation fields (camera view, textures, render stats)
+*   and the debug overlay toggle are not part of the snapshot and are kept on restore.
+*   The state hash is restored as saved, per asteroid hashes are rebuilt on next update.
+*
+*   Simulation values are stored as they are in GameState, floats or 16.16 fixed point
+*   integers (SUPPORT_FIXED_POINT), snapshots only load on builds using the same mode.
+*
+*   SNAPSHOT FORMAT (little-endian, fixed layout):
+*       SnapshotHeader                      Magic, version, total size, tick, build caps and number mode
+*       SnapshotGame                        Player, shots, beam, lives, score, timers, RNG, hash, chunk ticks
+*       SnapshotAsteroid[asteroidCount]     Live asteroids, grouped by chunk in list order
+*
+********************************************************************************************/
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "gameplay.h"                       // Required for: GameState
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SNAPSHOT_MAGIC              "RSNP"
+#define SNAPSHOT_VERSION            3
+
+#define SNAPSHOT_FLAG_FIXED_POINT   0x01    // Simulation values are 16.16 fixed point
+
+// Largest snapshot for this build caps, enough for any game state
+#define SNAPSHOT_MAX_SIZE           ((int)(sizeof(SnapshotHeader) + sizeof(SnapshotGame) + MAX_ASTEROIDS*sizeof(SnapshotAsteroid)))
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    char magic[4];                          // SNAPSHOT_MAGIC
+    unsigned int version;                   // SNAPSHOT_VERSION
+    unsigned int size;                      // Total snapshot size in bytes
+    unsigned int tick;                      // Simulation tick
+    unsigned int asteroidCount;             // Live asteroids stored
+    unsigned int maxAsteroids;              // MAX_ASTEROIDS of the build that saved it
+    unsigned short worldWidth;              // WORLD_WIDTH of the build that saved it
+    unsigned short worldHeight;             // WORLD_HEIGHT of the build that saved it
+    unsigned int flags;                     // SNAPSHOT_FLAG_* of the build that saved it
+} SnapshotHeader;
+
+typedef struct {
+    SimValue position[2];
+    SimValue speed[2];
+    SimValue rotation;
+    SimValue acceleration;
+    SimValue lifetime;
+    int type;
+    unsigned int active;
+} SnapshotEntity;
+
+typedef struct {
+    unsigned int rngState;
+    unsigned int stateHash[2];              // GameState.stateHash, low and high 32 bits
+    SnapshotEntity player;
+    SnapshotEntity superBeam;
+    SnapshotEntity shots[MAX_SHOTS];
+    SnapshotEntity lives[MAX_LIVES];
+    int asteroidScore;
+    int currentAsteroids;
+    int livesCount;
+    SimValue beamCharge;
+    SimValue beamDelay;
+    SimValue spawnInvincibility;
+    unsigned int isGameOver;
+    unsigned int preDetonation;
+    unsigned int chunkLastTick[MAX_CHUNKS];
+    unsigned int chunkVisitTick[MAX_CHUNKS];
+} SnapshotGame;
+
+typedef struct {
+    unsigned int slot;                      // Index in GameState.sAsteroids[]
+    unsigned int chunk;                     // Chunk list containing it
+    SimValue position[2];
+    SimValue speed[2];
+    SimValue rotation;
+    int type;
+} SnapshotAsteroid;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+int SnapshotSave(const GameState *game, unsigned char *buffer, int bufferSize);    // Save game to buffer, returns size, 0 if it does not fit
+bool SnapshotLoad(GameState *game, const unsigned char *data, int size);           // Restore game from snapshot, false (game untouched) if invalid
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,148 @@
+/*******************************************************************************************
+*
+*   startup_profiler - Startup timeline instrumentation
+*
+*   NOTE: First zone or mark defines the time origin and the main thread, zones from other
+*   threads are reported as worker zones
+*
+*   NOTE: This module does not include raylib.h on purpose, windows.h conflicts with it
+*
+********************************************************************************************/
+
+#include "startup_profiler.h"
+
+#if defined(SUPPORT_STARTUP_PROFILER)
+
+#include "thread.h"                         // Required for: ThreadGetCurrentId(), ATOMIC_LOAD(), ATOMIC_FETCH_ADD()
+
+#include <stdio.h>                          // Required for: printf(), fopen(), fprintf(), fclose()
+#include <stdbool.h>                        // Required for: bool
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>                    // Required for: QueryPerformanceCounter(), QueryPerformanceFrequency()
+#else
+    #include <time.h>                       // Required for: clock_gettime()
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    const char *name;
+    double start;                           // Seconds since time origin
+    double end;                             // Negative while running, same as start for marks
+    bool mainThread;
+} StartupZone;
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static StartupZone zones[STARTUP_MAX_ZONES] = { 0 };
+static unsigned int zoneCount = 0;
+static double timeOrigin = 0.0;
+static unsigned long long mainThreadId = 0;
+static bool reported = false;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static double GetClockTime(void);
+static int AddZone(const char *name);
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+int StartupZoneBegin(const char *name)
+{
+    return AddZone(name);
+}
+
+void StartupZoneEnd(int zone)
+{
+    if ((zone >= 0) && (zone < STARTUP_MAX_ZONES)) zones[zone].end = GetClockTime() - timeOrigin;
+}
+
+void StartupMark(const char *name)
+{
+    int zone = AddZone(name);
+    if (zone >= 0) zones[zone].end = zones[zone].start;
+}
+
+void StartupReport(const char *fileName)
+{
+    if (reported) return;
+    reported = true;
+
+    unsigned int count = (zoneCount < STARTUP_MAX_ZONES)? zoneCount : STARTUP_MAX_ZONES;
+
+    printf("STARTUP: %-32s %10s %10s\n", "Zone", "Start ms", "Time ms");
+    for (unsigned int i = 0; i < count; i++)
+    {
+        const StartupZone *zone = &zones[i];
+
+        if (zone->end == zone->start) printf("STARTUP: %-32s %10.2f %10s\n", zone->name, zone->start*1000.0, "-");
+        else if (zone->end < 0.0) printf("STARTUP: %-32s %10.2f %10s\n", zone->name, zone->start*1000.0, "running");
+        else printf("STARTUP: %-32s %10.2f %10.2f%s\n", zone->name, zone->start*1000.0, (zone->end - zone->start)*1000.0, zone->mainThread? "" : " (worker)");
+    }
+
+    FILE *file = fopen(fileName, "wt");
+    if (file == NULL) return;
+
+    fprintf(file, "{ \"traceEvents\": [\n");
+    for (unsigned int i = 0; i < count; i++)
+    {
+        const StartupZone *zone = &zones[i];
+        double end = (zone->end < 0.0)? zone->start : zone->end;
+
+        fprintf(file, "    { \"name\": \"%s\", \"ph\": \"%s\", \"ts\": %.1f, \"dur\": %.1f, \"pid\": 1, \"tid\": %i }%s\n",
+            zone->name, (end == zone->start)? "i" : "X", zone->start*1e6, (end - zone->start)*1e6, zone->mainThread? 1 : 2, (i < count - 1)? "," : "");
+    }
+    fprintf(file, "] }\n");
+    fclose(file);
+
+    printf("STARTUP: Timeline written to %s\n", fileName);
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Monotonic clock in seconds
+static double GetClockTime(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter = { 0 };
+    LARGE_INTEGER frequency = { 0 };
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+
+    return (double)counter.QuadPart/(double)frequency.QuadPart;
+#else
+    struct timespec now = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec + (double)now.tv_nsec*1e-9;
+#endif
+}
+
+static int AddZone(const char *name)
+{
+    // First call happens on the main thread, before any worker is started
+    if (ATOMIC_LOAD(&zoneCount) == 0)
+    {
+        timeOrigin = GetClockTime();
+        mainThreadId = ThreadGetCurrentId();
+    }
+
+    unsigned int zone = ATOMIC_FETCH_ADD(&zoneCount, 1);
+    if (zone >= STARTUP_MAX_ZONES) return -1;
+
+    zones[zone].name = name;
+    zones[zone].start = GetClockTime() - timeOrigin;
+    zones[zone].end = -1.0;
+    zones[zone].mainThread = (ThreadGetCurrentId() == mainThreadId);
+
+    return (int)zone;
+}
+
+#endif // SUPPORT_STARTUP_PROFILER
@@ -0,0 +1,47 @@
+/*******************************************************************************************
+*
+*   startup_profiler - Startup timeline instrumentation
+*
+*   Records timed zones and instant marks from program start until StartupReport() is called,
+*   from any thread. The report prints every zone with its start time and duration and writes
+*   the same timeline as a Chrome trace JSON file (open with chrome://tracing or Perfetto).
+*
+*   CONFIGURATION:
+*       #define SUPPORT_STARTUP_PROFILER
+*           Enable the profiler, otherwise all calls compile to nothing. Time is measured with
+*           the platform monotonic clock, so zones before InitWindow() are also valid
+*
+********************************************************************************************/
+
+#ifndef STARTUP_PROFILER_H
+#define STARTUP_PROFILER_H
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define STARTUP_MAX_ZONES           64      // Zones and marks recorded, later ones are ignored
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+#if defined(SUPPORT_STARTUP_PROFILER)
+int StartupZoneBegin(const char *name);     // Begin timed zone, name must be a static string, returns zone id
+void StartupZoneEnd(int zone);              // End timed zone, from the same thread that started it
+void StartupMark(const char *name);         // Record instant event
+void StartupReport(const char *fileName);   // Print report and write JSON timeline, only the first call reports
+#else
+    #define StartupZoneBegin(name) 0
+    #define StartupZoneEnd(zone) ((void)(zone))
+    #define StartupMark(name) ((void)0)
+    #define StartupReport(fileName) ((void)0)
+#endif
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // STARTUP_PROFILER_H
@@ -0,0 +1,178 @@
+/*******************************************************************************************
+*
+*   thread - Minimal portable threads and atomics
+*
+********************************************************************************************/
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+    #define _GNU_SOURCE                     // Required for: pthread_setaffinity_np(), CPU_SET()
+#endif
+
+#include "thread.h"
+
+#include <stdlib.h>                         // Required for: malloc(), free()
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>                    // Required for: WaitForSingleObject(), CloseHandle(), GetCurrentThreadId(), SetThreadAffinityMask(), Sleep()
+    #include <process.h>                    // Required for: _beginthreadex()
+#elif !defined(PLATFORM_WEB)
+    #define THREAD_POSIX
+    #include <pthread.h>                    // Required for: pthread_create(), pthread_join(), pthread_self()
+    #include <stdint.h>                     // Required for: uintptr_t
+    #include <unistd.h>                     // Required for: sysconf()
+    #include <time.h>                       // Required for: nanosleep()
+    #if defined(__linux__)
+        #include <sched.h>                  // Required for: cpu_set_t, CPU_ZERO(), CPU_SET()
+    #endif
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Thread entry point and its argument, platform entry points have different signatures
+typedef struct {
+    ThreadFunc func;
+    void *userData;
+} ThreadEntry;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+#if defined(_WIN32)
+static unsigned int __stdcall ThreadMain(void *arg);
+#elif defined(THREAD_POSIX)
+static void *ThreadMain(void *arg);
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+bool ThreadStart(Thread *thread, ThreadFunc func, void *userData)
+{
+    thread->handle = NULL;
+
+#if defined(_WIN32) || defined(THREAD_POSIX)
+    ThreadEntry *entry = (ThreadEntry *)malloc(sizeof(ThreadEntry));
+    if (entry == NULL) return false;
+
+    entry->func = func;
+    entry->userData = userData;
+
+#if defined(_WIN32)
+    thread->handle = (void *)_beginthreadex(NULL, 0, ThreadMain, entry, 0, NULL);
+#else
+    pthread_t *handle = (pthread_t *)malloc(sizeof(pthread_t));
+
+    if ((handle != NULL) && (pthread_create(handle, NULL, ThreadMain, entry) == 0)) thread->handle = handle;
+    else free(handle);
+#endif
+
+    if (thread->handle == NULL) free(entry);
+#else
+    (void)func;
+    (void)userData;
+#endif
+
+    return (thread->handle != NULL);
+}
+
+void ThreadJoin(Thread *thread)
+{
+    if (thread->handle == NULL) return;
+
+#if defined(_WIN32)
+    WaitForSingleObject((HANDLE)thread->handle, INFINITE);
+    CloseHandle((HANDLE)thread->handle);
+#elif defined(THREAD_POSIX)
+    pthread_join(*(pthread_t *)thread->handle, NULL);
+    free(thread->handle);
+#endif
+
+    thread->handle = NULL;
+}
+
+unsigned long long ThreadGetCurrentId(void)
+{
+#if defined(_WIN32)
+    return (unsigned long long)GetCurrentThreadId();
+#elif defined(THREAD_POSIX)
+    return (unsigned long long)(uintptr_t)pthread_self();
+#else
+    return 0;                               // Single threaded
+#endif
+}
+
+int ThreadGetCoreCount(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info = { 0 };
+    GetSystemInfo(&info);
+
+    return (info.dwNumberOfProcessors > 0)? (int)info.dwNumberOfProcessors : 1;
+#elif defined(THREAD_POSIX)
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return (count > 0)? (int)count : 1;
+#else
+    return 1;
+#endif
+}
+
+bool ThreadSetAffinity(int core)
+{
+    if ((core < 0) || (core >= ThreadGetCoreCount())) return false;
+
+#if defined(_WIN32)
+    if (core >= (int)(sizeof(DWORD_PTR)*8)) return false;
+
+    return (SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << core) != 0);
+#elif defined(THREAD_POSIX) && defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+
+    return (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0);
+#else
+    return false;                           // macOS only takes affinity hints, Web is single threaded
+#endif
+}
+
+void ThreadSleep(double seconds)
+{
+    if (seconds <= 0.0) return;
+
+#if defined(_WIN32)
+    Sleep((DWORD)(seconds*1000.0));
+#elif defined(THREAD_POSIX)
+    struct timespec duration = { (time_t)seconds, (long)((seconds - (double)(time_t)seconds)*1e9) };
+    nanosleep(&duration, NULL);
+#else
+    (void)seconds;
+#endif
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+#if defined(_WIN32)
+static unsigned int __stdcall ThreadMain(void *arg)
+{
+    ThreadEntry entry = *(ThreadEntry *)arg;
+    free(arg);
+
+    entry.func(entry.userData);
+
+    return 0;
+}
+#elif defined(THREAD_POSIX)
+static void *ThreadMain(void *arg)
+{
+    ThreadEntry entry = *(ThreadEntry *)arg;
+    free(arg);
+
+    entry.func(entry.userData);
+
+    return NULL;
+}
+#endif
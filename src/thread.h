@@ -0,0 +1,60 @@
+/*******************************************************************************************
+*
+*   thread - Minimal portable threads and atomics
+*
+*   Wraps pthreads on POSIX systems and Win32 threads on Windows. Web builds are compiled
+*   without pthreads support, ThreadStart() returns false there and callers must be able
+*   to do the same work on the main thread.
+*
+*   NOTE: This module does not include raylib.h on purpose, windows.h conflicts with it
+*
+********************************************************************************************/
+
+#ifndef THREAD_H
+#define THREAD_H
+
+#include <stdbool.h>                        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+// Atomics for indices and counters shared between threads
+#if defined(_MSC_VER)
+    #include <intrin.h>
+    #define ATOMIC_LOAD(ptr) ((unsigned int)_InterlockedOr((volatile long *)(ptr), 0))
+    #define ATOMIC_STORE(ptr, value) _InterlockedExchange((volatile long *)(ptr), (long)(value))
+    #define ATOMIC_FETCH_ADD(ptr, value) ((unsigned int)_InterlockedExchangeAdd((volatile long *)(ptr), (long)(value)))
+#else
+    #define ATOMIC_LOAD(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+    #define ATOMIC_STORE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+    #define ATOMIC_FETCH_ADD(ptr, value) __atomic_fetch_add((ptr), (value), __ATOMIC_ACQ_REL)
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef void (*ThreadFunc)(void *userData);
+
+typedef struct {
+    void *handle;                           // Platform thread handle, NULL if not running
+} Thread;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool ThreadStart(Thread *thread, ThreadFunc func, void *userData);     // Start thread, returns false if threads are not available
+void ThreadJoin(Thread *thread);                                        // Wait for thread to finish, does nothing if not running
+unsigned long long ThreadGetCurrentId(void);                            // Get calling thread id, unique among running threads
+int ThreadGetCoreCount(void);                                           // Get logical cores available, 1 if unknown
+bool ThreadSetAffinity(int core);                                       // Pin calling thread to a logical core, false if not supported
+void ThreadSleep(double seconds);                                       // Suspend calling thread, a bit longer than asked on some platforms
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif // THREAD_H
@@ -0,0 +1,155 @@
+/*******************************************************************************************
+*
+*   asset_packer - Asset bake tool, packs game assets into a single archive
+*
+*   Usage: asset_packer <assets.pak> <file01> [file02 ...]
+*
+*   Files are stored unmodified, named after their file name (i.e. "resources/atlas.png"
+*   is stored as "atlas.png"), so they can be loaded with the *FromMemory() functions or
+*   used directly if they are already in a pre-decoded format (i.e. sounds.pcm)
+*
+*   NOTE: Archive layout is described in pak.h, index is sorted by name for binary search
+*
+********************************************************************************************/
+
+#include "pak.h"
+
+#include <stdio.h>                          // Required for: printf(), fopen(), fread(), fwrite(), fclose()
+#include <stdlib.h>                         // Required for: calloc(), malloc(), free(), qsort()
+#include <string.h>                         // Required for: memcpy(), strlen(), strrchr(), strncmp()
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    PakEntry entry;
+    const char *path;
+} PackedFile;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static const char *GetPathFileName(const char *path);
+static int CompareFiles(const void *a, const void *b);
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        printf("Usage: asset_packer <assets.pak> <file01> [file02 ...]\n");
+        return 1;
+    }
+
+    int count = argc - 2;
+    PackedFile *files = (PackedFile *)calloc(count, sizeof(PackedFile));
+
+    for (int i = 0; i < count; i++)
+    {
+        const char *name = GetPathFileName(argv[2 + i]);
+
+        if (strlen(name) >= PAK_NAME_LENGTH)
+        {
+            printf("asset_packer: file name too long %s\n", name);
+            return 1;
+        }
+
+        memcpy(files[i].entry.name, name, strlen(name));
+        files[i].path = argv[2 + i];
+    }
+
+    qsort(files, count, sizeof(PackedFile), CompareFiles);
+
+    for (int i = 1; i < count; i++)
+    {
+        if (strncmp(files[i - 1].entry.name, files[i].entry.name, PAK_NAME_LENGTH) == 0)
+        {
+            printf("asset_packer: duplicated file name %s\n", files[i].entry.name);
+            return 1;
+        }
+    }
+
+    FILE *output = fopen(argv[1], "wb");
+
+    if (output == NULL)
+    {
+        printf("asset_packer: failed to write %s\n", argv[1]);
+        return 1;
+    }
+
+    // Index is written last, once every blob offset and size is known
+    PakHeader header = { 0 };
+    memcpy(header.magic, PAK_MAGIC, 4);
+    header.version = PAK_VERSION;
+    header.count = count;
+
+    unsigned int offset = sizeof(PakHeader) + count*sizeof(PakEntry);
+    static const unsigned char padding[PAK_ALIGNMENT] = { 0 };
+
+    fseek(output, offset, SEEK_SET);
+
+    for (int i = 0; i < count; i++)
+    {
+        FILE *input = fopen(files[i].path, "rb");
+
+        if (input == NULL)
+        {
+            printf("asset_packer: failed to load %s\n", files[i].path);
+            return 1;
+        }
+
+        fseek(input, 0, SEEK_END);
+        long size = ftell(input);
+        fseek(input, 0, SEEK_SET);
+
+        unsigned char *data = (unsigned char *)malloc((size > 0)? size : 1);
+        size_t read = fread(data, 1, size, input);
+        fclose(input);
+
+        if (read != (size_t)size)
+        {
+            printf("asset_packer: failed to read %s\n", files[i].path);
+            return 1;
+        }
+
+        unsigned int aligned = (offset + PAK_ALIGNMENT - 1)/PAK_ALIGNMENT*PAK_ALIGNMENT;
+        fwrite(padding, 1, aligned - offset, output);
+        fwrite(data, 1, size, output);
+        free(data);
+
+        files[i].entry.offset = aligned;
+        files[i].entry.size = (unsigned int)size;
+        offset = aligned + (unsigned int)size;
+    }
+
+    fseek(output, 0, SEEK_SET);
+    fwrite(&header, sizeof(PakHeader), 1, output);
+    for (int i = 0; i < count; i++) fwrite(&files[i].entry, sizeof(PakEntry), 1, output);
+    fclose(output);
+
+    printf("asset_packer: %i files packed (%u bytes)\n", count, offset);
+
+    free(files);
+
+    return 0;
+}
+
+//--------------------------------------------------------------------------------------------
+// Module functions definition
+//--------------------------------------------------------------------------------------------
+static const char *GetPathFileName(const char *path)
+{
+    const char *name = strrchr(path, '/');
+    const char *backslash = strrchr(path, '\\');
+
+    if ((name == NULL) || ((backslash != NULL) && (backslash > name))) name = backslash;
+
+    return (name != NULL)? name + 1 : path;
+}
+
+static int CompareFiles(const void *a, const void *b)
+{
+    return strncmp(((const PackedFile *)a)->entry.name, ((const PackedFile *)b)->entry.name, PAK_NAME_LENGTH);
+}
@@ -0,0 +1,197 @@
+/*******************************************************************************************
+*
+*   atlas_packer - Asset bake tool, packs game sprites into a single texture atlas
+*
+*   Usage: atlas_packer <atlas.png> <atlas_data.h> <sprite01.png> [sprite02.png ...]
+*
+*   Writes one atlas image plus a generated C header with the source rectangle of every
+*   sprite, in the same order they were provided on the command line. A small opaque white
+*   block is always appended so shapes can be drawn from the atlas (see SetShapesTexture())
+*
+*   NOTE: Sprites are shelf-packed by decreasing height, atlas size is rounded up to
+*   power-of-two dimensions for compatibility with GLES2/WebGL1 targets
+*
+********************************************************************************************/
+
+#include "raylib.h"
+
+#include <stdio.h>                          // Required for: printf(), fopen(), fprintf(), fclose()
+#include <stdlib.h>                         // Required for: calloc(), free()
+#include <string.h>                         // Required for: memcpy()
+#include <ctype.h>                          // Required for: toupper(), isalnum()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define ATLAS_MAX_WIDTH     1024            // Maximum atlas width before starting a new shelf
+#define ATLAS_PADDING       2               // Transparent pixels between sprites, avoids filtering bleed
+#define ATLAS_WHITE_SIZE    4               // White block size for shapes drawing
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct {
+    Image image;
+    Rectangle rec;
+    char name[64];
+} AtlasSprite;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static int NextPowerOfTwo(int value);
+static void SpriteNameFromPath(const char *path, char *name, int size);
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    if (argc < 4)
+    {
+        printf("Usage: atlas_packer <atlas.png> <atlas_data.h> <sprite01.png> [sprite02.png ...]\n");
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    int spriteCount = argc - 3 + 1;         // Input sprites + white block
+    AtlasSprite *sprites = (AtlasSprite *)calloc(spriteCount, sizeof(AtlasSprite));
+    int *order = (int *)calloc(spriteCount, sizeof(int));
+
+    for (int i = 0; i < spriteCount - 1; i++)
+    {
+        sprites[i].image = LoadImage(argv[3 + i]);
+
+        if (sprites[i].image.data == NULL)
+        {
+            printf("atlas_packer: failed to load %s\n", argv[3 + i]);
+            return 1;
+        }
+
+        ImageFormat(&sprites[i].image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        SpriteNameFromPath(argv[3 + i], sprites[i].name, sizeof(sprites[i].name));
+    }
+
+    sprites[spriteCount - 1].image = GenImageColor(ATLAS_WHITE_SIZE, ATLAS_WHITE_SIZE, WHITE);
+    SpriteNameFromPath("white", sprites[spriteCount - 1].name, sizeof(sprites[spriteCount - 1].name));
+
+    // Sort by decreasing height (stable), sprites with the same height share a shelf
+    for (int i = 0; i < spriteCount; i++) order[i] = i;
+    for (int i = 1; i < spriteCount; i++)
+    {
+        int current = order[i];
+        int j = i - 1;
+
+        while ((j >= 0) && (sprites[order[j]].image.height < sprites[current].image.height))
+        {
+            order[j + 1] = order[j];
+            j--;
+        }
+
+        order[j + 1] = current;
+    }
+
+    // Shelf packing
+    int penX = ATLAS_PADDING;
+    int penY = ATLAS_PADDING;
+    int shelfHeight = 0;
+    int usedWidth = 0;
+    int usedHeight = 0;
+
+    for (int i = 0; i < spriteCount; i++)
+    {
+        AtlasSprite *sprite = &sprites[order[i]];
+
+        if ((penX + sprite->image.width + ATLAS_PADDING) > ATLAS_MAX_WIDTH)
+        {
+            penX = ATLAS_PADDING;
+            penY += shelfHeight + ATLAS_PADDING;
+            shelfHeight = 0;
+        }
+
+        sprite->rec = (Rectangle){ (float)penX, (float)penY, (float)sprite->image.width, (float)sprite->image.height };
+
+        penX += sprite->image.width + ATLAS_PADDING;
+        if (sprite->image.height > shelfHeight) shelfHeight = sprite->image.height;
+        if (penX > usedWidth) usedWidth = penX;
+        if ((penY + shelfHeight + ATLAS_PADDING) > usedHeight) usedHeight = penY + shelfHeight + ATLAS_PADDING;
+    }
+
+    Image atlas = GenImageColor(NextPowerOfTwo(usedWidth), NextPowerOfTwo(usedHeight), BLANK);
+
+    // Copy sprite pixels row by row, no blending so alpha is preserved exactly
+    for (int i = 0; i < spriteCount; i++)
+    {
+        AtlasSprite *sprite = &sprites[i];
+
+        for (int y = 0; y < sprite->image.height; y++)
+        {
+            unsigned char *dst = (unsigned char *)atlas.data + (((int)sprite->rec.y + y)*atlas.width + (int)sprite->rec.x)*4;
+            unsigned char *src = (unsigned char *)sprite->image.data + (y*sprite->image.width)*4;
+            memcpy(dst, src, sprite->image.width*4);
+        }
+    }
+
+    if (!ExportImage(atlas, argv[1]))
+    {
+        printf("atlas_packer: failed to write %s\n", argv[1]);
+        return 1;
+    }
+
+    FILE *header = fopen(argv[2], "wt");
+
+    if (header == NULL)
+    {
+        printf("atlas_packer: failed to write %s\n", argv[2]);
+        return 1;
+    }
+
+    fprintf(header, "// Generated by atlas_packer, do not edit (regenerate with the bake_atlas target)\n");
+    fprintf(header, "#ifndef ATLAS_DATA_H\n#define ATLAS_DATA_H\n\n");
+    fprintf(header, "#define ATLAS_WIDTH %i\n", atlas.width);
+    fprintf(header, "#define ATLAS_HEIGHT %i\n", atlas.height);
+    fprintf(header, "#define ATLAS_SPRITE_COUNT %i\n\n", spriteCount);
+    for (int i = 0; i < spriteCount; i++) fprintf(header, "#define ATLAS_SPRITE_%s %i\n", sprites[i].name, i);
+    fprintf(header, "\n// Source rectangles into the atlas texture, indexed by ATLAS_SPRITE_*\n");
+    fprintf(header, "static const Rectangle atlasRects[ATLAS_SPRITE_COUNT] = {\n");
+    for (int i = 0; i < spriteCount; i++)
+    {
+        fprintf(header, "    { %i, %i, %i, %i },\n", (int)sprites[i].rec.x, (int)sprites[i].rec.y, (int)sprites[i].rec.width, (int)sprites[i].rec.height);
+    }
+    fprintf(header, "};\n\n#endif // ATLAS_DATA_H\n");
+    fclose(header);
+
+    printf("atlas_packer: %i sprites packed into %ix%i atlas\n", spriteCount, atlas.width, atlas.height);
+
+    UnloadImage(atlas);
+    for (int i = 0; i < spriteCount; i++) UnloadImage(sprites[i].image);
+    free(sprites);
+    free(order);
+
+    return 0;
+}
+
+//--------------------------------------------------------------------------------------------
+// Module functions definition
+//--------------------------------------------------------------------------------------------
+static int NextPowerOfTwo(int value)
+{
+    int result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+// Get sprite identifier from file path, i.e. "resources/small-a.png" -> "SMALL_A"
+static void SpriteNameFromPath(const char *path, char *name, int size)
+{
+    const char *fileName = GetFileNameWithoutExt(path);
+    int length = 0;
+
+    for (int i = 0; (fileName[i] != '\0') && (length < (size - 1)); i++)
+    {
+        name[length++] = isalnum((unsigned char)fileName[i])? (char)toupper((unsigned char)fileName[i]) : '_';
+    }
+
+    name[length] = '\0';
+}
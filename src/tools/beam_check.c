@@ -0,0 +1,108 @@
+/*******************************************************************************************
+*
+*   beam_check - Super beam stays inside the world for long runs
+*
+*   Usage: beam_check [ticks]
+*
+*   Fires a super beam and steps the game well past the time a fixed point position would
+*   overflow if the beam kept flying (about 9800 ticks), then fires a second one. Checks the
+*   beam is only ever active inside the world, stops once it leaves and can be fired again.
+*   Returns non zero on failure, registered as a CTest test.
+*
+*   NOTE: Simulation runs silent, sound effects are not initialized
+*
+********************************************************************************************/
+
+#include "raylib.h"
+#include "gameplay.h"
+
+#include <stdio.h>                          // Required for: printf()
+#include <stdlib.h>                         // Required for: atoi()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define CHECK_DEFAULT_TICKS         12000
+#define CHECK_REFIRE_TICK           6000    // Second beam fired here
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static GameState game = { 0 };
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    int ticks = (argc > 1)? atoi(argv[1]) : CHECK_DEFAULT_TICKS;
+    if (ticks <= CHECK_REFIRE_TICK) ticks = CHECK_DEFAULT_TICKS;
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    const GameplayApi *gameplay = GetGameplayApi();
+
+    game.rngState = 0x2545f491;
+    game.viewSize = (Vector2){ 800, 450 };
+    game.viewScale = 1.0f;
+    game.silent = true;
+    gameplay->GameReset(&game);
+
+    int fired = 0;
+    int left = 0;
+
+    for (int tick = 0; tick < ticks; tick++)
+    {
+        unsigned int input = 0;
+
+        // Ship kept alive, a game over would stop the beam with everything else
+        game.spawnInvincibility = SIM(2.0f);
+
+        if ((tick == 0) || (tick == CHECK_REFIRE_TICK))
+        {
+            game.beamCharge = SIM(100.0f);
+            input = GAME_INPUT_BEAM;
+        }
+
+        bool wasActive = game.sSuperBeam.active;
+        SimVector2 position = game.sSuperBeam.position;
+
+        gameplay->GameStep(&game, input);
+
+        if (!wasActive && game.sSuperBeam.active)
+        {
+            if (!game.preDetonation)
+            {
+                printf("FAIL: Beam fired at tick %i detonated right away\n", tick);
+                return 1;
+            }
+
+            fired++;
+        }
+        else if (wasActive && !game.sSuperBeam.active) left++;
+        else if (!game.sSuperBeam.active && ((position.x != game.sSuperBeam.position.x) || (position.y != game.sSuperBeam.position.y)))
+        {
+            printf("FAIL: Inactive beam moved at tick %i\n", tick);
+            return 1;
+        }
+
+        if (game.sSuperBeam.active &&
+            ((game.sSuperBeam.position.x < 0) || (game.sSuperBeam.position.x >= SIM_FROM_INT(WORLD_WIDTH)) ||
+             (game.sSuperBeam.position.y < 0) || (game.sSuperBeam.position.y >= SIM_FROM_INT(WORLD_HEIGHT))))
+        {
+            printf("FAIL: Beam active out of the world at tick %i, (%.1f, %.1f)\n", tick,
+                SIM_TO_FLOAT(game.sSuperBeam.position.x), SIM_TO_FLOAT(game.sSuperBeam.position.y));
+            return 1;
+        }
+    }
+
+    if ((fired != 2) || (left != 2) || game.sSuperBeam.active)
+    {
+        printf("FAIL: %i beams fired, %i left the world, beam %s at the end\n", fired, left, game.sSuperBeam.active? "active" : "inactive");
+        return 1;
+    }
+
+    printf("OK: %i ticks, %i beams fired and left the world\n", ticks, fired);
+
+    return 0;
+}
@@ -0,0 +1,34 @@
+# embed_resources - Asset bake script, writes resources as C byte arrays to be compiled into the game
+#
+# Usage: cmake -DOUTPUT=<embedded_resources.c> -DINPUTS=<file01;file02;...> -P embed_resources.cmake
+#
+# Every file is stored under its file name (i.e. "resources/atlas.png" as "atlas.png"), see embedded.h
+# NOTE: Plain CMake script so it also runs when cross-compiling (Web), no host tool required
+
+if(NOT OUTPUT OR NOT INPUTS)
+    message(FATAL_ERROR "Usage: cmake -DOUTPUT=<embedded_resources.c> -DINPUTS=<file01;file02;...> -P embed_resources.cmake")
+endif()
+
+set(source "// Generated by embed_resources.cmake, do not edit\n#include \"embedded.h\"\n\n")
+set(table "")
+set(index 0)
+
+foreach(input IN LISTS INPUTS)
+    get_filename_component(name ${input} NAME)
+    file(READ ${input} hex HEX)
+    file(SIZE ${input} size)
+
+    # 16 bytes per line, hex string has two characters per byte
+    string(REPEAT "[0-9a-f]" 32 line)
+    string(REGEX REPLACE "(${line})" "\\1\n" hex "${hex}")
+    string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${hex}")
+    string(REPLACE "\n" "\n    " bytes "${bytes}")
+
+    string(APPEND source "// ${name}, ${size} bytes\nstatic const unsigned char EMBEDDED_ALIGN resource${index}[${size} + 1] = {\n    ${bytes}0x00\n};\n\n")
+    string(APPEND table "    { \"${name}\", resource${index}, ${size} },\n")
+    math(EXPR index "${index} + 1")
+endforeach()
+
+string(APPEND source "const EmbeddedFile embeddedFiles[] = {\n${table}};\n\nconst int embeddedFileCount = ${index};\n")
+
+file(WRITE ${OUTPUT} "${source}")
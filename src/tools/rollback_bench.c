@@ -0,0 +1,143 @@
+/*******************************************************************************************
+*
+*   rollback_bench - Rollback costs at the asteroid cap it is built with
+*
+*   Usage: rollback_bench [ticks]
+*
+*   Plays the game with scripted inputs and reports state save and restore costs, raw copy
+*   (see rollback.h) against snapshot serialization (see snapshot.h), and the frame cost of
+*   rolling back every frame at each depth: remote inputs arrive depth ticks late and never
+*   match the prediction, the worst case for ROLLBACK_MAX_FRAMES.
+*
+*   NOTE: Built once per asteroid cap (rollback_bench_<cap>), MAX_ASTEROIDS is a build flag.
+*   Simulation runs silent, sound effects are not initialized
+*
+********************************************************************************************/
+
+#include "raylib.h"
+#include "gameplay.h"
+#include "rollback.h"
+#include "snapshot.h"
+#include "net_socket.h"                     // Required for: NetGetTime()
+
+#include <stdio.h>                          // Required for: printf()
+#include <stdlib.h>                         // Required for: atoi()
+#include <stddef.h>                         // Required for: offsetof()
+#include <string.h>                         // Required for: memcpy()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define BENCH_WARMUP_TICKS          600     // Ticks played before measuring, asteroids split and spread
+#define BENCH_DEFAULT_TICKS         600     // Ticks measured per depth
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static GameState game = { 0 };
+static GameState start = { 0 };             // State after warmup, every measure starts from it
+static unsigned char saved[sizeof(GameState)] = { 0 };
+static unsigned char snapshot[SNAPSHOT_MAX_SIZE] = { 0 };
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static unsigned int GetScriptedInput(unsigned int tick, bool remote);
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    int ticks = (argc > 1)? atoi(argv[1]) : BENCH_DEFAULT_TICKS;
+    if (ticks <= 0) ticks = BENCH_DEFAULT_TICKS;
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    const GameplayApi *gameplay = GetGameplayApi();
+
+    game.rngState = 0x2545f491;
+    game.spawnInvincibility = SIM(2.0f);
+    game.viewSize = (Vector2){ 800, 450 };
+    game.viewScale = 1.0f;
+    game.silent = true;
+    gameplay->GameReset(&game);
+
+    for (unsigned int tick = 0; tick < BENCH_WARMUP_TICKS; tick++) gameplay->GameStep(&game, GetScriptedInput(tick, false) | GetScriptedInput(tick, true));
+
+    start = game;
+
+    printf("MAX_ASTEROIDS %i, %i live asteroids, %i ticks per measure\n", MAX_ASTEROIDS, game.liveAsteroids, ticks);
+
+    // Save and restore, raw copy against snapshot serialization
+    double time = NetGetTime();
+    for (int i = 0; i < ticks; i++) memcpy(saved, &game, offsetof(GameState, camera));
+    double copySave = (NetGetTime() - time)/ticks;
+
+    time = NetGetTime();
+    for (int i = 0; i < ticks; i++) memcpy(&game, saved, offsetof(GameState, camera));
+    double copyLoad = (NetGetTime() - time)/ticks;
+
+    int snapshotSize = 0;
+    time = NetGetTime();
+    for (int i = 0; i < ticks; i++) snapshotSize = SnapshotSave(&game, snapshot, sizeof(snapshot));
+    double snapshotSave = (NetGetTime() - time)/ticks;
+
+    time = NetGetTime();
+    for (int i = 0; i < ticks; i++) SnapshotLoad(&game, snapshot, snapshotSize);
+    double snapshotLoad = (NetGetTime() - time)/ticks;
+
+    game = start;
+    time = NetGetTime();
+    for (int i = 0; i < ticks; i++) gameplay->GameStep(&game, GetScriptedInput(i, false));
+    double step = (NetGetTime() - time)/ticks;
+
+    printf("Raw copy:   %7i bytes, %8.2f us save, %8.2f us restore\n", (int)offsetof(GameState, camera), copySave*1000000.0, copyLoad*1000000.0);
+    printf("Snapshot:   %7i bytes, %8.2f us save, %8.2f us restore\n", snapshotSize, snapshotSave*1000000.0, snapshotLoad*1000000.0);
+    printf("Tick:       %8.2f us\n\n", step*1000000.0);
+
+    // Rollback every frame, remote inputs depth ticks late and always mispredicted
+    printf("Depth   Frame avg   Frame worst   Rollbacks   Budget used (16.7 ms)\n");
+
+    for (int depth = 1; depth <= ROLLBACK_MAX_FRAMES; depth *= 2)
+    {
+        game = start;
+        RollbackInit(gameplay);
+
+        double total = 0.0;
+        double worst = 0.0;
+        int rollbacks = 0;
+
+        for (int frame = 0; frame < ticks; frame++)
+        {
+            if (frame >= depth) RollbackAddRemoteInput(frame - depth, GetScriptedInput(frame - depth, true) | GAME_INPUT_SHOOT);
+            RollbackAddLocalInput(GetScriptedInput(frame, false));
+
+            time = NetGetTime();
+            RollbackAdvance(&game);
+            time = NetGetTime() - time;
+
+            total += time;
+            if (time > worst) worst = time;
+            if (frame >= depth) rollbacks++;
+        }
+
+        printf("%5i   %6.3f ms     %6.3f ms    %9i   %5.1f%%\n", depth, total/ticks*1000.0, worst*1000.0, rollbacks, worst*GAME_TICK_RATE*100.0);
+    }
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Local peer turns and shoots, remote one thrusts in bursts, both restart when the game is over
+static unsigned int GetScriptedInput(unsigned int tick, bool remote)
+{
+    if (remote) return (((tick/45)%2) == 0)? GAME_INPUT_THRUST : GAME_INPUT_RESTART;
+
+    unsigned int input = (((tick/90)%2) == 0)? GAME_INPUT_LEFT : GAME_INPUT_RIGHT;
+    if ((tick%8) == 0) input |= GAME_INPUT_SHOOT;
+
+    return input;
+}
@@ -0,0 +1,115 @@
+/*******************************************************************************************
+*
+*   sound_baker - Asset bake tool, pre-decodes game sounds into a raw PCM cache
+*
+*   Usage: sound_baker <sounds.pcm> <sampleRate> <sampleSize> <channels> <sound01> [sound02 ...]
+*
+*   Decodes every sound (any format supported by LoadWave()) and converts it to the requested
+*   format, which should match the audio device (or SFX mixer) format so nothing has to be
+*   converted at runtime. Entries are named after the source file name, i.e. "laser.mp3"
+*
+*   NOTE: Container layout is described in pcm_cache.h
+*
+********************************************************************************************/
+
+#include "raylib.h"
+#include "pcm_cache.h"
+
+#include <stdio.h>                          // Required for: printf(), fopen(), fwrite(), fclose()
+#include <stdlib.h>                         // Required for: atoi(), calloc(), free()
+#include <string.h>                         // Required for: memcpy(), strlen()
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    if (argc < 6)
+    {
+        printf("Usage: sound_baker <sounds.pcm> <sampleRate> <sampleSize> <channels> <sound01> [sound02 ...]\n");
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    int sampleRate = atoi(argv[2]);
+    int sampleSize = atoi(argv[3]);
+    int channels = atoi(argv[4]);
+    int count = argc - 5;
+
+    if ((sampleRate <= 0) || ((sampleSize != 16) && (sampleSize != 32)) || ((channels != 1) && (channels != 2)) || (count > PCM_CACHE_MAX_ENTRIES))
+    {
+        printf("sound_baker: unsupported output format %i Hz, %i bit, %i channels\n", sampleRate, sampleSize, channels);
+        return 1;
+    }
+
+    Wave *waves = (Wave *)calloc(count, sizeof(Wave));
+    PcmCacheEntry *entries = (PcmCacheEntry *)calloc(count, sizeof(PcmCacheEntry));
+    unsigned int offset = sizeof(PcmCacheHeader) + count*sizeof(PcmCacheEntry);
+
+    for (int i = 0; i < count; i++)
+    {
+        const char *fileName = GetFileName(argv[5 + i]);
+
+        if (strlen(fileName) >= PCM_CACHE_NAME_LENGTH)
+        {
+            printf("sound_baker: file name too long %s\n", fileName);
+            return 1;
+        }
+
+        waves[i] = LoadWave(argv[5 + i]);
+
+        if (waves[i].data == NULL)
+        {
+            printf("sound_baker: failed to load %s\n", argv[5 + i]);
+            return 1;
+        }
+
+        WaveFormat(&waves[i], sampleRate, sampleSize, channels);
+
+        offset = (offset + PCM_CACHE_ALIGNMENT - 1)/PCM_CACHE_ALIGNMENT*PCM_CACHE_ALIGNMENT;
+
+        memcpy(entries[i].name, fileName, strlen(fileName));
+        entries[i].offset = offset;
+        entries[i].frameCount = waves[i].frameCount;
+        entries[i].sampleRate = waves[i].sampleRate;
+        entries[i].sampleSize = (unsigned short)waves[i].sampleSize;
+        entries[i].channels = (unsigned short)waves[i].channels;
+
+        offset += waves[i].frameCount*waves[i].channels*(waves[i].sampleSize/8);
+    }
+
+    FILE *output = fopen(argv[1], "wb");
+
+    if (output == NULL)
+    {
+        printf("sound_baker: failed to write %s\n", argv[1]);
+        return 1;
+    }
+
+    PcmCacheHeader header = { 0 };
+    memcpy(header.magic, PCM_CACHE_MAGIC, 4);
+    header.version = PCM_CACHE_VERSION;
+    header.count = count;
+
+    fwrite(&header, sizeof(PcmCacheHeader), 1, output);
+    fwrite(entries, sizeof(PcmCacheEntry), count, output);
+
+    static const unsigned char padding[PCM_CACHE_ALIGNMENT] = { 0 };
+
+    for (int i = 0; i < count; i++)
+    {
+        fwrite(padding, 1, entries[i].offset - ftell(output), output);
+        fwrite(waves[i].data, 1, waves[i].frameCount*waves[i].channels*(waves[i].sampleSize/8), output);
+    }
+
+    fclose(output);
+
+    printf("sound_baker: %i sounds baked at %i Hz, %i bit, %i channels (%u bytes)\n", count, sampleRate, sampleSize, channels, offset);
+
+    for (int i = 0; i < count; i++) UnloadWave(waves[i]);
+    free(waves);
+    free(entries);
+
+    return 0;
+}
@@ -0,0 +1,173 @@
+/*******************************************************************************************
+*
+*   spectator_bench - Spectator stream bandwidth and encode cost as spectators are added
+*
+*   Usage: spectator_bench [ticks] [port]
+*
+*   Runs the game on a large world with a spectator host (see net_spectator.h) and adds
+*   spectators over loopback UDP, 1 to NET_MAX_SPECTATORS, each with its view at a different
+*   place around the player. Reports packet bytes per second and encode time per spectator
+*   against sending every spectator the full state delta (see net_snapshot.h).
+*
+*   NOTE: World size, asteroid cap and spawn count are build flags, see CMakeLists.txt.
+*   Simulation runs silent, sound effects are not initialized
+*
+********************************************************************************************/
+
+#include "raylib.h"
+#include "gameplay.h"
+#include "net_snapshot.h"
+#include "net_spectator.h"
+#include "net_socket.h"                     // Required for: NetSocket, NetSocketSend(), NetSocketReceive(), NetGetTime()
+#include "net_session.h"                    // Required for: NET_PROTOCOL_ID
+
+#include <stdio.h>                          // Required for: printf()
+#include <stdlib.h>                         // Required for: atoi()
+#include <math.h>                           // Required for: floorf()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define BENCH_WARMUP_TICKS          300     // Ticks played before measuring, asteroids split and spread
+#define BENCH_DEFAULT_TICKS         180     // Ticks per spectator count, last GAME_TICK_RATE ones are reported
+#define BENCH_DEFAULT_PORT          27970
+#define BENCH_VIEW_WIDTH            800
+#define BENCH_VIEW_HEIGHT           450
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static GameState game = { 0 };
+static NetSocket sockets[NET_MAX_SPECTATORS] = { 0 };
+static NetState previous = { 0 };
+static NetState current = { 0 };
+static unsigned char packet[NET_SOCKET_MAX_PACKET] = { 0 };
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Declaration
+//----------------------------------------------------------------------------------
+static void SendView(NetSocket *sock, unsigned short port, int index);
+static unsigned int GetScriptedInput(unsigned int tick);
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    int ticks = (argc > 1)? atoi(argv[1]) : BENCH_DEFAULT_TICKS;
+    unsigned short port = (argc > 2)? (unsigned short)atoi(argv[2]) : BENCH_DEFAULT_PORT;
+    if (ticks < GAME_TICK_RATE) ticks = GAME_TICK_RATE;
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    const GameplayApi *gameplay = GetGameplayApi();
+
+    game.rngState = 0x2545f491;
+    game.spawnInvincibility = SIM(2.0f);
+    game.viewSize = (Vector2){ BENCH_VIEW_WIDTH, BENCH_VIEW_HEIGHT };
+    game.viewScale = 1.0f;
+    game.silent = true;
+    gameplay->GameReset(&game);
+
+    for (unsigned int tick = 0; tick < BENCH_WARMUP_TICKS; tick++) gameplay->GameStep(&game, GetScriptedInput(tick));
+
+    if (!NetSpectatorHostStart(port))
+    {
+        printf("Port %i is not available\n", port);
+        return 1;
+    }
+
+    printf("World %ix%i, MAX_ASTEROIDS %i, %i live asteroids, budget %i B per spectator tick\n\n",
+        WORLD_WIDTH, WORLD_HEIGHT, MAX_ASTEROIDS, game.liveAsteroids, NET_SPECTATOR_BUDGET);
+    printf("Spectators   Interest KB/s   Encode/spectator   Relevant   Sent   Deferred   Full delta KB/s   Encode/client\n");
+
+    unsigned int tick = BENCH_WARMUP_TICKS;
+    int spectatorCount = 0;
+
+    for (int count = 1; count <= NET_MAX_SPECTATORS; count *= 2)
+    {
+        for (; spectatorCount < count; spectatorCount++)
+        {
+            if (!NetSocketOpen(&sockets[spectatorCount], 0))
+            {
+                printf("Spectator socket not available\n");
+                return 1;
+            }
+        }
+
+        double deltaTime = 0.0;
+        long long deltaBytes = 0;
+
+        for (int t = 0; t < ticks; t++, tick++)
+        {
+            for (int i = 0; i < spectatorCount; i++) SendView(&sockets[i], port, i);
+
+            previous = current;
+            gameplay->GameStep(&game, GetScriptedInput(tick));
+            NetSpectatorHostUpdate(&game);
+
+            // Spectators only drain, bytes are counted by the host
+            unsigned short from = 0;
+            for (int i = 0; i < spectatorCount; i++) while (NetSocketReceive(&sockets[i], packet, sizeof(packet), &from) > 0) { }
+
+            // Full state delta against the previous tick, the best case for an acknowledged baseline
+            double start = NetGetTime();
+            NetStateCapture(&game, tick, &current);
+            int size = NetStateWriteDelta((previous.tick != NET_NO_BASELINE)? &previous : NULL, &current, packet, sizeof(packet));
+
+            if (t >= (ticks - GAME_TICK_RATE))
+            {
+                deltaTime += NetGetTime() - start;
+                deltaBytes += size;
+            }
+        }
+
+        NetSpectatorHostStats stats = NetSpectatorHostGetStats();
+
+        printf("%10i   %13.1f   %13.2f us   %8.0f   %4.0f   %8.0f   %15.1f   %10.2f us\n", spectatorCount, stats.bytesPerSecond/1024.0f,
+            stats.encodeTime*1000000.0f, stats.relevant, stats.sent, stats.deferred,
+            (double)deltaBytes*spectatorCount/1024.0, deltaTime/GAME_TICK_RATE*1000000.0);
+    }
+
+    for (int i = 0; i < spectatorCount; i++) NetSocketClose(&sockets[i]);
+    NetSpectatorHostStop();
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Spectator views on a grid around the player, the first ones see the simulated chunks
+static void SendView(NetSocket *sock, unsigned short port, int index)
+{
+    float x = SIM_TO_FLOAT(game.sPlayer.position.x) + (float)((index%4) - 1)*BENCH_VIEW_WIDTH;
+    float y = SIM_TO_FLOAT(game.sPlayer.position.y) + (float)(((index/4)%4) - 1)*BENCH_VIEW_HEIGHT;
+
+    x -= floorf(x/WORLD_WIDTH)*WORLD_WIDTH;
+    y -= floorf(y/WORLD_HEIGHT)*WORLD_HEIGHT;
+
+    packet[0] = NET_PROTOCOL_ID;
+    packet[1] = NET_SPECTATOR_PROTOCOL_VERSION;
+    packet[2] = NET_PACKET_SPECTATOR_VIEW;
+
+    unsigned int values[4] = { (unsigned int)x, (unsigned int)y, BENCH_VIEW_WIDTH, BENCH_VIEW_HEIGHT };
+
+    for (int i = 0; i < 4; i++)
+    {
+        packet[3 + i*2] = (unsigned char)values[i];
+        packet[4 + i*2] = (unsigned char)(values[i] >> 8);
+    }
+
+    NetSocketSend(sock, port, packet, 11);
+}
+
+// Ship turns, thrusts in bursts and shoots, restarts when the game is over
+static unsigned int GetScriptedInput(unsigned int tick)
+{
+    unsigned int input = (((tick/90)%2) == 0)? GAME_INPUT_LEFT : GAME_INPUT_RIGHT;
+    if (((tick/45)%2) == 0) input |= GAME_INPUT_THRUST;
+    if ((tick%8) == 0) input |= GAME_INPUT_SHOOT;
+
+    return input | GAME_INPUT_RESTART;
+}